@@ -0,0 +1,150 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      analyze.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file reads a reference trace recorded by oss [-t] and
+//                   prints the LRU and OPT fault counts for a range of frame
+//                   counts, so the whole miss ratio curve comes from one run
+//                   instead of one recompiled run per frame count.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBRARIES/NAMESPACE
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <iomanip>
+#include <unistd.h>
+#include <cstdlib>
+#include <time.h>
+#include "shm.h"
+#include "mrc.h"
+#include "paging.h"
+using namespace std;
+
+// ONE TRACE REFERENCE
+struct Reference {
+    pid_t pid;
+    long long page;
+    int action;
+};
+
+// FUNCTION PROTOTYPES
+void printUsage();
+template <class Policy> void replayTrace(const vector<Reference>&, int, int);
+
+// MAIN
+int main(int argc, char** argv) {
+    // VARIABLES FOR COMMAND LINE PARSING
+    string traceName;
+    int maxFrames = FRAME_COUNT;
+    int step = FRAME_COUNT / 16;
+    int opt;
+    // VARIABLES FOR READING THE TRACE
+    vector<long long> keys;
+    vector<Reference> references;
+    pid_t pid;
+    long long page;
+    int action;
+    string policyName;
+
+    // BEGIN PARSING COMMAND LINE ARGUMENTS USING FLAGS
+    while ((opt = getopt(argc, argv, "ht:m:s:p:")) != -1) {
+        switch (opt) {
+        case 'h': // h - display help/usage message and exit (success)
+            printUsage();
+            return 0;
+        case 't': // t flag - trace file recorded by oss
+            traceName = optarg;
+            break;
+        case 'm': // m flag - largest frame count on the curve
+            maxFrames = atoi(optarg);
+            break;
+        case 's': // s flag - frame count step between curve points
+            step = atoi(optarg);
+            break;
+        case 'p': // p flag - replay the trace through the replay engine with this policy
+            policyName = optarg;
+            break;
+        default: // default case - display usage and exit
+            cerr << "Usage Invalid.\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (traceName.empty() || maxFrames <= 0 || step <= 0) {
+        cerr << "ERROR: A trace file (-t) and positive -m and -s are required.\n";
+        printUsage();
+        return 1;
+    }
+    if (!policyName.empty() && ((policyName != "lru" && policyName != "clock") || maxFrames > FRAME_COUNT)) {
+        cerr << "ERROR: Replay (-p) takes lru or clock and at most " << FRAME_COUNT << " frames.\n";
+        printUsage();
+        return 1;
+    }
+
+    // READ THE TRACE (pid page action PER LINE)
+    ifstream trace(traceName);
+    if (!trace) {
+        cerr << "ERROR: trace file could not be opened" << endl;
+        exit(1);
+    }
+    while (trace >> pid >> page >> action) {
+        keys.push_back(referenceKey(pid, page));
+        references.push_back({ pid, page, action });
+    }
+
+    printMissRatioCurve(cout, keys, maxFrames, step);
+    if (policyName == "lru") {
+        replayTrace<LruPolicy>(references, maxFrames, step);
+    }
+    else if (policyName == "clock") {
+        replayTrace<ClockPolicy>(references, maxFrames, step);
+    }
+    return 0;
+}
+
+// FUNCTION TO REPLAY THE TRACE THROUGH THE REPLAY ENGINE AT EVERY CURVE POINT
+// (an LRU replay must match the stack distance curve, which checks both)
+template <class Policy>
+void replayTrace(const vector<Reference>& references, int maxFrames, int step) {
+    struct timespec start;
+    struct timespec end;
+    double seconds;
+
+    cout << "REPLAY (" << Policy::name() << ", " << references.size() << " references)\n";
+    cout << setw(8) << "Frames" << setw(12) << "Faults" << setw(12) << "Rate" << setw(12) << "Dirty Evs" << setw(12) << "ns/Ref" << endl;
+    for (int frames = step; frames <= maxFrames; frames += step) {
+        //the frame table is too large for the stack
+        unique_ptr<ReplayEngine<PAGE_SIZE, FRAME_COUNT, Policy>> engine(new ReplayEngine<PAGE_SIZE, FRAME_COUNT, Policy>(frames));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (const Reference& ref : references) {
+            engine->accessPage(ref.pid, ref.page, ref.action == 1);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        cout << setw(8) << frames << setw(12) << engine->faults << setw(12) << fixed << setprecision(4)
+             << (references.empty() ? 0.0 : (double)engine->faults / references.size()) << setw(12) << engine->dirtyEvictions
+             << setw(12) << setprecision(1) << (references.empty() ? 0.0 : seconds * 1e9 / references.size()) << endl;
+        cout.unsetf(ios::fixed);
+    }
+}
+
+// FUNCTION TO PRINT HELP MESSAGE/USAGE
+void printUsage() {
+    cout << "Usage: analyze [-h] -t trace [-m maxFrames] [-s step] [-p policy]\n";
+    cout << " -t trace      -> Reference trace written by oss -t\n";
+    cout << " -m maxFrames  -> Largest frame count on the curve (default " << FRAME_COUNT << ")\n";
+    cout << " -s step       -> Frame count step between curve points (default " << FRAME_COUNT / 16 << ")\n";
+    cout << " -p policy     -> Also replay the trace through the replay engine with lru or clock\n";
+}
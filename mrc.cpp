@@ -0,0 +1,252 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      mrc.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file implements the miss ratio curve analysis. A Fenwick
+//                   tree over reference times marks the most recent reference of
+//                   every page, so the number of distinct pages touched since a
+//                   page's last reference (its LRU stack distance) is one prefix
+//                   sum. Belady's OPT is simulated with a set ordered by next use.
+//                   The SHARDS estimator runs the same distance computation on a
+//                   hash-sampled subset of keys and scales the results back up.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBRARIES/NAMESPACE
+#include <iomanip>
+#include <set>
+#include <unordered_map>
+#include <climits>
+#include <algorithm>
+#include "shm.h"
+#include "mrc.h"
+using namespace std;
+
+// FUNCTION TO BUILD THE KEY OF A (PROCESS, VIRTUAL PAGE) REFERENCE
+long long referenceKey(pid_t pid, long long vpn) {
+    return pageKey(pid, vpn);
+}
+
+// FUNCTION TO ADD TO ONE FENWICK TREE POSITION
+static void fenwickAdd(vector<int>& tree, size_t pos, int value) {
+    for (pos++; pos < tree.size(); pos += pos & (0 - pos)) {
+        tree[pos] += value;
+    }
+}
+
+// FUNCTION TO SUM FENWICK TREE POSITIONS [0, pos)
+static long long fenwickSum(const vector<int>& tree, size_t pos) {
+    long long sum = 0;
+    for (; pos > 0; pos -= pos & (0 - pos)) {
+        sum += tree[pos];
+    }
+    return sum;
+}
+
+// FUNCTION TO COMPUTE THE LRU STACK DISTANCE OF EVERY REFERENCE IN ONE PASS
+StackDistances computeStackDistances(const vector<long long>& keys) {
+    StackDistances result;
+    vector<int> tree(keys.size() + 1, 0);
+    unordered_map<long long, size_t> lastRef;
+    long long distance;
+
+    result.references = keys.size();
+    result.coldMisses = 0;
+    result.histogram.assign(2, 0);
+    for (size_t t = 0; t < keys.size(); t++) {
+        auto found = lastRef.find(keys[t]);
+        if (found == lastRef.end()) {
+            result.coldMisses++;
+        }
+        else {
+            //distinct pages referenced at or after the previous reference
+            distance = fenwickSum(tree, t) - fenwickSum(tree, found->second);
+            if (distance >= (long long)result.histogram.size()) {
+                result.histogram.resize(distance + 1, 0);
+            }
+            result.histogram[distance]++;
+            fenwickAdd(tree, found->second, -1);
+        }
+        fenwickAdd(tree, t, 1);
+        lastRef[keys[t]] = t;
+    }
+    return result;
+}
+
+// FUNCTION TO COUNT LRU FAULTS WITH A GIVEN NUMBER OF FRAMES
+long long lruFaults(const StackDistances& distances, int frames) {
+    long long faults = distances.coldMisses;
+    for (size_t d = frames + 1; d < distances.histogram.size(); d++) {
+        faults += distances.histogram[d];
+    }
+    return faults;
+}
+
+// FUNCTION TO COUNT FAULTS OF BELADY'S OPTIMAL POLICY WITH A GIVEN NUMBER OF FRAMES
+long long optFaults(const vector<long long>& keys, int frames) {
+    vector<long long> nextUse(keys.size());
+    unordered_map<long long, long long> upcoming;
+    unordered_map<long long, long long> residentNext;
+    set<pair<long long, long long>> resident; // (next use, key), latest next use evicted first
+    long long faults = 0;
+
+    //NEXT USE OF EVERY REFERENCE (LLONG_MAX = NEVER AGAIN)
+    for (size_t t = keys.size(); t-- > 0; ) {
+        auto found = upcoming.find(keys[t]);
+        nextUse[t] = (found == upcoming.end()) ? LLONG_MAX - (long long)t : found->second;
+        upcoming[keys[t]] = t;
+    }
+
+    for (size_t t = 0; t < keys.size(); t++) {
+        auto found = residentNext.find(keys[t]);
+        if (found != residentNext.end()) {
+            resident.erase({ found->second, keys[t] });
+        }
+        else {
+            faults++;
+            if ((int)resident.size() >= frames) {
+                auto victim = prev(resident.end());
+                residentNext.erase(victim->second);
+                resident.erase(victim);
+            }
+        }
+        resident.insert({ nextUse[t], keys[t] });
+        residentNext[keys[t]] = nextUse[t];
+    }
+    return faults;
+}
+
+// FUNCTION TO PRINT THE LRU AND OPT FAULT COUNTS FOR FRAME COUNTS step, 2*step, ... AND maxFrames ITSELF
+void printMissRatioCurve(ostream& out, const vector<long long>& keys, int maxFrames, int step) {
+    StackDistances distances = computeStackDistances(keys);
+    long long lru;
+    long long opt;
+
+    out << "MISS RATIO CURVE (" << distances.references << " references, " << distances.coldMisses << " distinct pages)\n";
+    out << setw(8) << "Frames" << setw(12) << "LRU Faults" << setw(12) << "LRU Rate" << setw(12) << "OPT Faults" << setw(12) << "OPT Rate" << endl;
+    for (int frames = step; frames < maxFrames + step; frames += step) {
+        if (frames > maxFrames) {
+            frames = maxFrames; // the last point is always the largest size asked for
+        }
+        lru = lruFaults(distances, frames);
+        opt = optFaults(keys, frames);
+        out << setw(8) << frames << setw(12) << lru << setw(12) << fixed << setprecision(4)
+            << (distances.references > 0 ? (double)lru / distances.references : 0.0)
+            << setw(12) << opt << setw(12) << (distances.references > 0 ? (double)opt / distances.references : 0.0) << endl;
+        out.unsetf(ios::fixed);
+    }
+}
+
+// FUNCTION TO HASH A REFERENCE KEY INTO [0, SHARDS_MODULUS)
+static unsigned int shardsHash(long long key) {
+    unsigned long long x = (unsigned long long)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return (unsigned int)(x % SHARDS_MODULUS);
+}
+
+// FUNCTION TO RENUMBER TRACKED KEYS 0..n-1 WHEN THE LOGICAL CLOCK REACHES THE END OF THE TREE
+static void shardsCompact(ShardsEstimator& est) {
+    vector<pair<long long, long long>> order; // (time, key)
+    for (auto& entry : est.lastRef) {
+        order.push_back({ entry.second, entry.first });
+    }
+    sort(order.begin(), order.end());
+    fill(est.tree.begin(), est.tree.end(), 0);
+    for (size_t i = 0; i < order.size(); i++) {
+        est.lastRef[order[i].second] = i;
+        fenwickAdd(est.tree, i, 1);
+    }
+    est.clock = order.size();
+}
+
+// FUNCTION TO RESET AN ESTIMATOR, rate IS THE INITIAL FRACTION OF KEYS SAMPLED
+void shardsInit(ShardsEstimator& est, int maxKeys, double rate) {
+    est.maxKeys = maxKeys;
+    est.threshold = (unsigned int)(rate * SHARDS_MODULUS);
+    est.references = 0;
+    est.sampled = 0;
+    est.clock = 0;
+    est.tree.assign(2 * maxKeys + 1, 0);
+    est.lastRef.clear();
+    est.byHash.clear();
+    est.histogram.assign(SHARDS_MAX_DISTANCE + 1, 0.0);
+    est.coldMisses = 0.0;
+}
+
+// FUNCTION TO OFFER ONE REFERENCE TO THE ESTIMATOR
+void shardsReference(ShardsEstimator& est, long long key) {
+    unsigned int hash = shardsHash(key);
+    double rate;
+    long long distance;
+    size_t scaled;
+
+    est.references++;
+    if (hash >= est.threshold) {
+        return;
+    }
+    est.sampled++;
+    rate = (double)est.threshold / SHARDS_MODULUS;
+    if (est.clock + 1 >= (long long)est.tree.size()) {
+        shardsCompact(est);
+    }
+
+    auto found = est.lastRef.find(key);
+    if (found == est.lastRef.end()) {
+        est.coldMisses += 1.0 / rate;
+        est.byHash.insert({ hash, key });
+    }
+    else {
+        //sampled distance scaled back up to the full key space
+        distance = fenwickSum(est.tree, est.clock) - fenwickSum(est.tree, found->second);
+        scaled = (size_t)(distance / rate + 0.5);
+        if (scaled > SHARDS_MAX_DISTANCE) {
+            est.coldMisses += 1.0 / rate;
+        }
+        else {
+            est.histogram[scaled] += 1.0 / rate;
+        }
+        fenwickAdd(est.tree, found->second, -1);
+    }
+    fenwickAdd(est.tree, est.clock, 1);
+    est.lastRef[key] = est.clock;
+    est.clock++;
+
+    //OVER THE KEY BOUND - LOWER THE THRESHOLD TO THE LARGEST TRACKED HASH
+    while ((int)est.byHash.size() > est.maxKeys) {
+        est.threshold = prev(est.byHash.end())->first;
+        while (!est.byHash.empty() && prev(est.byHash.end())->first >= est.threshold) {
+            auto victim = prev(est.byHash.end());
+            fenwickAdd(est.tree, est.lastRef[victim->second], -1);
+            est.lastRef.erase(victim->second);
+            est.byHash.erase(victim);
+        }
+    }
+}
+
+// FUNCTION TO ESTIMATE THE LRU MISS RATIO WITH A GIVEN NUMBER OF FRAMES
+// dividing by the offered references credits any sampling shortfall to distance 1 (SHARDS_adj)
+double shardsMissRatio(const ShardsEstimator& est, int frames) {
+    double misses = est.coldMisses;
+    double ratio;
+
+    if (est.references == 0) {
+        return 0.0;
+    }
+    for (size_t d = frames + 1; d < est.histogram.size(); d++) {
+        misses += est.histogram[d];
+    }
+    ratio = misses / est.references;
+    return ratio < 0.0 ? 0.0 : (ratio > 1.0 ? 1.0 : ratio);
+}
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      mrc.h
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This header declares the miss ratio curve analysis shared by
+//                   oss and the analyze tool. One pass over a reference stream
+//                   gives the LRU stack distance of every reference (Mattson's
+//                   algorithm over a Fenwick tree), which yields the LRU fault
+//                   count for every frame count at once. Belady's OPT fault
+//                   count is computed per frame count as a lower bound. A
+//                   SHARDS estimator samples references by key hash so oss can
+//                   keep an approximate curve up to date while it runs.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MRC_H
+#define MRC_H
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <sys/types.h>
+
+//STACK DISTANCE HISTOGRAM OF A REFERENCE STREAM
+struct StackDistances {
+    long long references;
+    long long coldMisses;             // first touch of a page, a fault at any size
+    std::vector<long long> histogram; // histogram[d] = re-references at stack distance d (1 = MRU)
+};
+
+//SHARDS SETTINGS
+#define SHARDS_MODULUS (1 << 24)    // key hashes fall in [0, SHARDS_MODULUS)
+#define SHARDS_GLOBAL_KEYS 2048     // most keys the global estimator tracks
+#define SHARDS_PROCESS_KEYS 256     // most keys a per-process estimator tracks
+#define SHARDS_MAX_DISTANCE 1024    // longer estimated distances count as misses at every size
+
+//SAMPLED REUSE DISTANCE ESTIMATOR (FIXED SIZE SHARDS)
+//keys whose hash is below the threshold are tracked; when more than maxKeys
+//are tracked the threshold drops to evict the largest hashes, so memory is bounded
+struct ShardsEstimator {
+    int maxKeys;
+    unsigned int threshold;
+    long long references;                                // every reference offered
+    long long sampled;                                   // references that passed the hash filter
+    long long clock;                                     // logical time of the next sampled reference
+    std::vector<int> tree;                               // Fenwick tree over logical times
+    std::unordered_map<long long, long long> lastRef;    // tracked key -> logical time of last reference
+    std::set<std::pair<unsigned int, long long>> byHash; // tracked keys, largest hash evicted first
+    std::vector<double> histogram;                       // scaled distance -> scaled reference count
+    double coldMisses;                                   // scaled first touches and overflowing distances
+};
+
+//FUNCTION PROTOTYPES
+long long referenceKey(pid_t pid, long long vpn);
+StackDistances computeStackDistances(const std::vector<long long>& keys);
+long long lruFaults(const StackDistances& distances, int frames);
+long long optFaults(const std::vector<long long>& keys, int frames);
+void printMissRatioCurve(std::ostream& out, const std::vector<long long>& keys, int maxFrames, int step);
+void shardsInit(ShardsEstimator& est, int maxKeys, double rate);
+void shardsReference(ShardsEstimator& est, long long key);
+double shardsMissRatio(const ShardsEstimator& est, int frames);
+
+#endif //MRC_H
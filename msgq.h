@@ -1,32 +1,59 @@
-////////////////////////////////////////////////////////////////////////////////////////////
-//
-//      msgq.h
-//
-//      Created By: Autumn Rose
-//
-//      CMPSCI 4760 - Operating Systems
-//      Project 6: Paging
-//
-//      Due Date: 15 May 2025
-//
-//      Description: This file provides the message buffer structure and permissions
-//              required for message passing between oss and worker.
-//
-////////////////////////////////////////////////////////////////////////////////////////////
-
-#ifndef MSGQ_H
-#define MSGQ_H
-
-//LIBRARIES
-
-#define PERMS 0644
-
-typedef struct msgBuffer {
-    long mtype;
-    pid_t pid;
-    int address;
-    int action;
-    int status;
-} msgBuffer;
-
-#endif //MSGQ_H
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//      msgq.h
+//
+//      Created By: Autumn Rose
+//
+//      CMPSCI 4760 - Operating Systems
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file provides the message buffer structure and permissions
+//              required for message passing between oss and worker.
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MSGQ_H
+#define MSGQ_H
+
+//LIBRARIES
+#include <cerrno>
+#include <sys/msg.h>
+
+#define PERMS 0644
+
+//STATUS VALUES BESIDES 0 (REQUEST/RESPONSE) AND -1 (TERMINATION)
+#define MSG_ASSIGN 1 // oss to pooled worker: run simulated process [pid] in table slot [address]
+#define MSG_RETIRE 2 // oss to pooled worker: exit
+
+//MTYPES OF MESSAGES TO OSS - OSS RECEIVES WITH -OSS_MTYPE_BATCH SO LATENCY CLASS MESSAGES COME FIRST
+#define OSS_MTYPE_LATENCY 1
+#define OSS_MTYPE_BATCH 2
+
+//MTYPE OF MESSAGES TO A WORKER - ITS PID MOVED PAST THE REQUEST MTYPES, SO A WORKER WITH A
+//SMALL PID (OSS AS PID 1 IN A CONTAINER FORKS PID 2) CAN'T BE MISTAKEN FOR A REQUEST CLASS
+#define WORKER_MTYPE(pid) ((long)(pid) + OSS_MTYPE_BATCH)
+
+typedef struct msgBuffer {
+    long mtype;
+    pid_t pid;
+    unsigned long long address; // 64-bit virtual address
+    int action;
+    int status;
+    int requestId; // echoed back so workers with several requests in flight can match replies
+    int frame;     // frame holding the page, set in replies so workers can touch its data
+} msgBuffer;
+
+//FUNCTION TO SEND A MESSAGE, BLOCKING WHILE THE QUEUE IS FULL
+//msgsnd is never restarted after a signal handler (even with SA_RESTART), so an
+//interrupted send is retried
+static inline int sendMessage(int msqid, msgBuffer* buf) {
+    int result;
+    do {
+        result = msgsnd(msqid, buf, sizeof(msgBuffer) - sizeof(long), 0);
+    } while (result == -1 && errno == EINTR);
+    return result;
+}
+
+#endif //MSGQ_H
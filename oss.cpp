@@ -1,794 +1,2622 @@
-//////////////////////////////////////////////////////////////////////////////////////
-//
-//      oss.cpp
-//
-//      Created By: Autumn Rose
-//
-//      CMP SCI 4760 - Operating Systems
-//
-//      Project 6: Paging
-//
-//      Due Date: 15 May 2025
-//
-//      Description: This file parses command line arguments, initializes a simulated
-//                   system clock and frame table in shared memory, and creates
-//                   a process table for which it will maintain while launching workers
-//                   (see worker.cpp) within the given parameters given by the accepted
-//                   arguments.
-//
-//////////////////////////////////////////////////////////////////////////////////////
-
-// INCLUDED LIBRARIES/NAMESPACE
-#include <iostream>
-#include <iomanip>
-#include <unistd.h>
-#include <sys/types.h>
-#include <sys/wait.h>
-#include <fcntl.h>
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <sys/ipc.h>
-#include <sys/msg.h>
-#include <time.h>
-#include <cstdlib>
-#include <string>
-#include <vector>
-#include <algorithm>
-#include <signal.h>
-#include <fstream>
-#include <queue>
-#include <climits>
-#include "shm.h"
-#include "msgq.h"
-using namespace std;
-
-#define MAX_PROCS 20
-
-// FRAME TABLE
-Frame frames[FRAME_COUNT];
-
-// LOG TRACKING
-int logLinesWritten = 0;
-const int MAX_LOG_LINES = 10000;
-
-// MEMORY TRACKING
-int totalMemoryAccesses = 0;
-int totalPageFaults = 0;
-time_t startWallTime;
-
-// PROCESS CONTROL BLOCK / PROCESS TABLE
-struct PCB {
-    int occupied;
-    pid_t pid;
-    int startSeconds;
-    int startNano;
-    int messagesSent;
-    int pageTable[PAGE_COUNT];
-    int memoryAccesses;
-};
-struct PCB processTable[20];
-
-// SHARED MEMORY
-int shmid;
-ShmSegment* shmData = nullptr;
-int msqid;
-
-// FUNCTION PROTOTYPES
-void printUsage();
-void incrementClock();
-void updatePCBofTerminatedChild(pid_t);
-void outputProcessTable();
-void signal_handler(int);
-int countActiveChildren();
-int openSpaceInTable();
-bool timeToLaunchProcess(int, int, int);
-int findProcessIndex(pid_t);
-void outputFrameTable(ofstream&);
-
-// QUEUE STRUCTURES AND DEFINITIONS
-struct BlockedProcess {
-    pid_t pid;
-    int processIndex;
-    int page;
-    int address;
-    int action;
-    int frameIndex;
-    int unblockAtSec;
-    int unblockAtNano;
-};
-vector<BlockedProcess> blockedQueue;
-
-// MAIN
-int main(int argc, char** argv) {
-    // VARIABLES FOR COMMAND LINE PARSING
-    int proc = 0;
-    int simul = 0;
-    int intervalInMsToLaunchChildren = 0;
-    string logfile;
-    int opt;
-    // VARIABLES FOR INTERMITTENTLY OUTPUTTING THE PROCESS TABLE
-    int lastPrintTimeSec = 0;
-    int lastPrintTimeNano = 0;
-    int elapsedPrintTimeSec;
-    int elapsedPrintTimeNano;
-    int elapsedTotalTimeNano;
-    // VARIABLES FOR LAUNCHING NEW PROCESS
-    int launchedChildren = 0;
-    int activeChildren;
-    int lastLaunchSec = 0;
-    int lastLaunchNano = 0;
-    int openIndex;
-    int status;
-    pid_t launchedPid;
-    time_t launchingStartTime = time(NULL);
-    // VARIABLES FOR MESSAGE PASSING
-    int currentIndex = 0;
-    int startIndex;
-    bool found = false;
-    msgBuffer buf;
-    key_t key;
-    system("touch msgq.txt");
-    pid_t childMessaging;
-    int totalMessagesSent = 0;
-    int termPid;
-    pid_t terminatedPid;
-    // VARIABLES FOR RESOURCE MANAGEMENT
-    int processIndex;
-    // VARIABLES FOR BLOCKED PROCESSES
-    int idx;
-    int rsc;
-    // VARIABLES FOR LOGFILE SETTINGS
-    bool verbose = true;
-    // VARIABLES FOR PAGING
-    int address;
-    int action;
-    pid_t pid;
-    int page;
-    int offset;
-    int frameIndex;
-    int delayNano;
-    int selectedFrame;
-    long long oldestTime;
-    long long frameTime;
-    int oldPid;
-    int oldPage;
-    int oldIndex;
-    startWallTime = time(NULL);
-    int accesses;
-    float effectiveTime;
-    long long unblockTime;
-    long long timeNow;
-    int unblockSec;
-    int unblockNano;
-    int frameIdx;
-    int fIdx;
-    int normalTerminations = 0;
-
-    // INITIALIZE TIMEOUT SIGNAL
-    signal(SIGALRM, signal_handler);
-    alarm(5);
-
-    // BEGIN PARSING COMMAND LINE ARGUMENTS USING FLAGS
-    while ((opt = getopt(argc, argv, "hn:s:i:f:")) != -1) {
-        switch (opt) {
-        case 'h': // h - display help/usage message and exit (success)
-            printUsage();
-            return 0;
-        case 'n': // n flag - store total children to launch
-            proc = atoi(optarg);
-            break;
-        case 's': // s flag - store number of children able to run simultaneously
-            simul = atoi(optarg);
-            break;
-        case 'i': // i flag - store interval to launch children
-            intervalInMsToLaunchChildren = atoi(optarg);
-            break;
-        case 'f': // f flag - store name for output file
-            logfile = optarg;
-            break;
-        default: // default case - display usage and exit
-            cerr << "Usage Invalid.\n";
-            printUsage();
-            return 1;
-        }
-    }
-
-    // VALIDATING COMMAND LINE ARGUMENTS
-    if (proc <= 0 || simul <= 0 || intervalInMsToLaunchChildren <= 0) {
-        cerr << "ERROR: All arguments for flags -n, -s, and -i must be positive integers.\n";
-        printUsage();
-        return 1;
-    }
-
-    // ENFORCE MAX PROCS AS 100
-    if (proc > 100) {
-        proc = 100;
-    }
-
-    // ENFORCE MAX SIMUL PROCS AS 18
-    if (simul > 18) {
-        simul = 18;
-    }
-
-    // CREATE LOG FILE WITH SPECIFIED NAME
-    ofstream file(logfile);
-    if (!file) {
-        cerr << "ERROR: log file could not be opened" << endl;
-        exit(1);
-    }
-
-    // INITIALIZE FRAME TABLE
-    for (int i = 0; i < FRAME_COUNT; i++) {
-        frames[i].occupied = false;
-        frames[i].dirty = false;
-        frames[i].pid = -1;
-        frames[i].pageNumber = -1;
-        frames[i].lastRefSec = 0;
-        frames[i].lastRefNano = 0;
-    }
-
-    // INITIALIZE SIMULATED CLOCK IN SHARED MEMORY
-    shmid = shmget(SHM_KEY, BUFF_SZ, IPC_CREAT | 0666);
-    if (shmid == -1) {
-        cerr << "ERROR: Failed to create shared memory." << endl;
-        exit(1);
-    }
-    shmData = (ShmSegment*)shmat(shmid, NULL, 0);
-    if (shmData == (void*)-1) {
-        cerr << "ERROR: Failed to attach to shared memory." << endl;
-        exit(1);
-    }
-    shmData->clock.seconds = 0;
-    shmData->clock.nano = 0;
-
-    // INITIALIZE MESSAGE PASSING
-    if ((key = ftok("msgq.txt", 1)) == -1) { //get key
-        cerr << "ERROR: ftok in oss \n";
-        exit(1);
-    }
-    if ((msqid = msgget(key, PERMS | IPC_CREAT)) == -1) { //create msgq
-        cerr << "ERROR: msgget in oss \n";
-        exit(1);
-    }
-
-    //---------------------------------------------------------------
-    // ENTER LOOP TO MAINTAIN CLOCK/PROCESS TABLE AND LAUNCH CHILDREN
-    while (launchedChildren < proc || countActiveChildren() > 0) {
-        incrementClock();
-        //HANDLE RECEIVED MESSAGES AND PAGING
-        while (msgrcv(msqid, &buf, sizeof(msgBuffer), 1, IPC_NOWAIT) != -1) {
-            address = buf.address;
-            action = buf.action;
-            pid = buf.pid;
-            page = address / PAGE_SIZE;
-            offset = address % PAGE_SIZE;
-            processIndex = findProcessIndex(buf.pid);
-            frameIndex = processTable[processIndex].pageTable[page];
-
-            cout << "OSS: P" << processIndex << " requesting " << (action == 0 ? "read" : "write") << " of address " << address << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
-            if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                file << "OSS: P" << processIndex << " requesting " << (action == 0 ? "read" : "write") << " of address " << address << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
-                logLinesWritten++;
-            }
-            if (frameIndex != -1 && frames[frameIndex].occupied && frames[frameIndex].pid == pid && frames[frameIndex].pageNumber == page) {
-                //PAGE ALREADY IN MEMORY
-                frames[frameIndex].lastRefSec = shmData->clock.seconds;
-                frames[frameIndex].lastRefNano = shmData->clock.nano;
-                if (action == 1) {
-                    frames[frameIndex].dirty = true;
-                }
-                totalMemoryAccesses++;
-                processTable[processIndex].memoryAccesses++;
-
-                //INCREMENT CLOCK
-                shmData->clock.nano += 100;
-                if (shmData->clock.nano >= SECOND) {
-                    shmData->clock.seconds++;
-                    shmData->clock.nano -= SECOND;
-                }
-
-                //SEND RESPONSE TO WORKER
-                buf.mtype = pid;
-                buf.status = 0;
-                cout << "OSS page hit for P" << processIndex << ", frame " << frameIndex << ". Sending response.\n";
-                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                    file << "OSS: page hit for P" << processIndex << ", frame " << frameIndex << ". Sending response.\n";
-                    logLinesWritten++;
-                }
-                if (msgsnd(msqid, &buf, sizeof(msgBuffer) - sizeof(long), 0) == -1) {
-                    cerr << "OSS: msgsnd response failed\n";
-                    exit(1);
-                }
-
-                cout << "OSS: Address " << address << " in frame " << frameIndex << ", giving data to P" << processIndex << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
-                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                    file << "OSS: Address " << address << " in frame " << frameIndex << ", giving data to P" << processIndex << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
-                    logLinesWritten++;
-                }
-            }
-            else {
-                //PAGE FAULT
-                cout << "OSS: Address " << address << " is not in a frame, pagefault" << endl;
-                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                    file << "OSS: Address " << address << " is not in a frame, pagefault" << endl;
-                    logLinesWritten++;
-                }
-                delayNano = 14 * 1000000;
-                shmData->clock.nano += delayNano;
-                if (shmData->clock.nano >= SECOND) {
-                    shmData->clock.seconds += shmData->clock.nano / SECOND;
-                    shmData->clock.nano %= SECOND;
-                }
-                totalMemoryAccesses++;
-                totalPageFaults++;
-
-                //FIND OPEN FRAME
-                selectedFrame = -1;
-                for (int i = 0; i < FRAME_COUNT; ++i) {
-                    if (!frames[i].occupied) {
-                        selectedFrame = i;
-                        break;
-                    }
-                }
-
-                if (selectedFrame == -1) {
-                    oldestTime = LLONG_MAX;
-                    for (int i = 0; i < FRAME_COUNT; ++i) {
-                        frameTime = ((long long)frames[i].lastRefSec * SECOND) + frames[i].lastRefNano;
-                        if (frameTime < oldestTime) {
-                            oldestTime = frameTime;
-                            selectedFrame = i;
-                        }
-                    }
-
-                    cout << "OSS: Clearing frame " << selectedFrame << " and swapping in P" << processIndex << " page " << page << endl;
-                    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                        file << "OSS: Clearing frame " << selectedFrame << " and swapping in P" << processIndex << " page " << page << endl;
-                        logLinesWritten++;
-                    }
-
-                    if (frames[selectedFrame].dirty) {
-                        cout << "OSS: Dirty bit of frame " << selectedFrame << " set, adding additional time to the clock" << endl;
-                        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                            file << "OSS: Dirty bit of frame " << selectedFrame << " set, adding additional time to the clock" << endl;
-                            logLinesWritten++;
-                        }
-                        shmData->clock.nano += delayNano;
-                        if (shmData->clock.nano >= SECOND) {
-                            shmData->clock.seconds += shmData->clock.nano / SECOND;
-                            shmData->clock.nano %= SECOND;
-                        }
-                    }
-
-                    //CLEAR OLD PAGE ENTRY
-                    oldPid = frames[selectedFrame].pid;
-                    oldPage = frames[selectedFrame].pageNumber;
-                    oldIndex = findProcessIndex(oldPid);
-                    if (oldIndex != -1) {
-                        processTable[oldIndex].pageTable[oldPage] = -1;
-                    }
-
-                    if (frames[selectedFrame].dirty) {
-                        cout << "OSS: Swapped out dirty frame. Adding 14ms I/O delay." << endl;
-                        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                            file << "OSS: Swapped out dirty frame. Adding 14ms I/O delay." << endl;
-                            logLinesWritten++;
-                        }
-                        shmData->clock.nano += delayNano;
-                        if (shmData->clock.nano >= SECOND) {
-                            shmData->clock.seconds += shmData->clock.nano / SECOND;
-                            shmData->clock.nano %= SECOND;
-                        }
-                    }
-                }
-
-                //SCHEDULE UNBLOCK TIME
-                unblockNano = shmData->clock.nano + 14 * 1000000;
-                unblockSec = shmData->clock.seconds;
-                if (unblockNano >= SECOND) {
-                    unblockSec += unblockNano / SECOND;
-                    unblockNano %= SECOND;
-                }
-
-                //CREATE BLOCKED MEMORY REQUEST
-                BlockedProcess bp;
-                bp.pid = pid;
-                bp.processIndex = processIndex;
-                bp.page = page;
-                bp.address = address;
-                bp.action = action;
-                bp.frameIndex = selectedFrame;
-                bp.unblockAtSec = unblockSec;
-                bp.unblockAtNano = unblockNano;
-                blockedQueue.push_back(bp);
-                cout << "OSS: Queued page load for PID " << pid << " into frame " << selectedFrame << ", will unblock at " << unblockSec << ":" << unblockNano << endl;
-                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                    file << "OSS: Queue page load for PID " << pid << " into frame " << selectedFrame << ", will unblock at " << unblockSec << ":" << unblockNano << endl;
-                    logLinesWritten++;
-                }
-
-                //ASSIGN FRAME TO THIS PAGE
-                frames[selectedFrame].occupied = true;
-                frames[selectedFrame].pid = pid;
-                frames[selectedFrame].pageNumber = page;
-                frames[selectedFrame].dirty = (action == 1);
-                frames[selectedFrame].lastRefSec = shmData->clock.seconds;
-                frames[selectedFrame].lastRefNano = shmData->clock.nano;
-                processTable[processIndex].pageTable[page] = selectedFrame;
-                cout << "OSS: Loaded page " << page << " for PID " << pid << " into frame " << selectedFrame << endl;
-                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                    file << "OSS: Loaded page " << page << " for PID " << pid << " into frame " << selectedFrame << endl;
-                    logLinesWritten++;
-                }
-
-                //RESPOND TO WORKER
-                buf.mtype = pid;
-                buf.status = 0;
-                if (msgsnd(msqid, &buf, sizeof(msgBuffer) - sizeof(long), 0) == -1) {
-                    cerr << "OSS: msgsnd response after page fault failed\n";
-                    exit(1);
-                }
-                        }
-
-                        //HANDLE TERMINATING PROCESSES
-                        if (buf.status == -1) {
-                            processIndex = findProcessIndex(buf.pid);
-                            accesses = processTable[processIndex].memoryAccesses;
-                            effectiveTime = accesses > 0 ? ((float)accesses * 100) / 1000000000 : 0.0f;
-                            cout << "OSS: PID " << buf.pid << " is terminating. Releasing all frames. Effective memory access time: " << effectiveTime << " sec" << endl;
-                            if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                                file << "OSS: PID " << buf.pid << " terminating. Releasing all frames. Effective memory access time: " << effectiveTime << " sec" << endl;
-                                logLinesWritten++;
-                            }
-                            for (int i = 0; i < PAGE_COUNT; i++) {
-                                frameIdx = processTable[processIndex].pageTable[i];
-                                if (frameIdx != -1 && frames[frameIdx].occupied && frames[frameIdx].pid == buf.pid) {
-                                    frames[frameIdx].occupied = false;
-                                    frames[frameIdx].dirty = false;
-                                    frames[frameIdx].pid = -1;
-                                    frames[frameIdx].pageNumber = -1;
-                                    frames[frameIdx].lastRefSec = 0;
-                                    frames[frameIdx].lastRefNano = 0;
-                                    processTable[processIndex].pageTable[i] = -1;
-                                }
-                            }
-                            updatePCBofTerminatedChild(buf.pid);
-                            normalTerminations++;
-                            waitpid(buf.pid, NULL, 0);
-                        }
-                        incrementClock();
-                }
-
-                //UNBLOCK ANY READY PROCESSES
-                for (auto it = blockedQueue.begin(); it != blockedQueue.end(); ) {
-                    timeNow = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
-                    unblockTime = (long long)it->unblockAtSec * SECOND + it->unblockAtNano;
-
-                    //check if time to unblock
-                    if (timeNow >= unblockTime) {
-                        fIdx = it->frameIndex;
-
-                        //set frame
-                        frames[fIdx].occupied = true;
-                        frames[fIdx].pid = it->pid;
-                        frames[fIdx].pageNumber = it->page;
-                        frames[fIdx].dirty = (it->action == 1);
-                        frames[fIdx].lastRefSec = shmData->clock.seconds;
-                        frames[fIdx].lastRefNano = shmData->clock.nano;
-                        processTable[it->processIndex].pageTable[it->page] = fIdx;
-                        //send message back
-                        buf.mtype = it->pid;
-                        buf.pid = it->pid;
-                        buf.status = 0;
-                        buf.address = it->address;
-                        buf.action = it->action;
-                        cout << "OSS unblocking P" << processIndex << " after page load\n";
-                        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                            file << "OSS: unblocking P" << processIndex << " after page load\n";
-                            logLinesWritten++;
-                        }
-                        if (msgsnd(msqid, &buf, sizeof(msgBuffer) - sizeof(long), 0) == -1) {
-                            cerr << "OSS: msgsnd failed on unblock\n";
-                            exit(1);
-                        }
-                        cout << "OSS: Indicating to P" << it->processIndex << " that " << (it->action == 0 ? "read" : "write") << " has happened to address " << it->address << endl;
-                        cout << "OSS: Finished page load for PID " << it->pid << " (page " << it->page << ") into frame " << fIdx << endl;
-                        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                            file << "OSS: Indicating to P" << it->processIndex << " that " << (it->action == 0 ? "read" : "write") << " has happened to address " << it->address << endl;
-                            logLinesWritten++;
-                            file << "OSS: Finished page load for PID " << it->pid << " (page " << it->page << ") into frame " << fIdx << endl;
-                            logLinesWritten++;
-                        }
-                    }
-                    else {
-                        ++it;
-                    }
-                    it = blockedQueue.erase(it);
-                }
-
-                //CLEAN UP ANY TERMINATED PROCESSES
-                while ((terminatedPid = waitpid(-1, &status, WNOHANG)) > 0) {
-                    cout << "OSS: Detected terminated child with PID " << terminatedPid << endl;
-                    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-                        file << "OSS: Detected terminated child with PID " << terminatedPid << endl;
-                        logLinesWritten++;
-                    }
-                    updatePCBofTerminatedChild(terminatedPid);
-                    normalTerminations++;
-                }
-
-                //OUTPUT PROCESS TABLE EVERY HALF SECOND
-                elapsedPrintTimeSec = shmData->clock.seconds - lastPrintTimeSec;
-                elapsedPrintTimeNano = shmData->clock.nano - lastPrintTimeNano;
-                if (elapsedPrintTimeNano < 0) {
-                    elapsedPrintTimeSec = shmData->clock.seconds - lastPrintTimeSec;
-                    elapsedPrintTimeNano += SECOND;
-                }
-                elapsedTotalTimeNano = (elapsedPrintTimeSec * SECOND) + elapsedPrintTimeNano;
-                if (elapsedTotalTimeNano >= 1000000000) {
-                    outputProcessTable();
-                    outputFrameTable(file);
-                    lastPrintTimeSec = shmData->clock.seconds;
-                    lastPrintTimeNano = shmData->clock.nano;
-                }
-
-                // LAUNCH NEW CHILD IF WITHIN BOUNDS OF SPECIFICATIONS
-                activeChildren = countActiveChildren();
-                // CHECK IF STILL CHILDREN TO LAUNCH
-                if (launchedChildren < proc) {
-                    // CHECK IF MAX ACTIVE CHILDREN ALREADY MET
-                    if (activeChildren < simul) {
-                        // CHECK IF REQUIRED TIME HAS PASSED TO LAUNCH NEW CHILD
-                        if (timeToLaunchProcess(lastLaunchSec, lastLaunchNano, intervalInMsToLaunchChildren)) {
-                            // CHECK IF OPEN SPOT IN PROCESS TABLE
-                            openIndex = openSpaceInTable();
-                            if (openIndex >= 0) {
-                                //fork new child
-                                launchedPid = fork();
-                                if (launchedPid < 0) {
-                                    cerr << "ERROR: Fork failed." << endl;
-                                    exit(1);
-                                }
-                                //inside child
-                                else if (launchedPid == 0) {
-                                    //exec worker - replace child
-                                    execlp("./worker", "worker", (char*)nullptr);
-                                    //check for failed exec
-                                    cerr << "ERROR: Exec failed." << endl;
-                                    exit(1);
-                                } else { //inside oss
-                                    //add new process info to process table
-                                    processTable[openIndex].occupied = 1;
-                                    processTable[openIndex].pid = launchedPid;
-                                    processTable[openIndex].startSeconds = shmData->clock.seconds;
-                                    processTable[openIndex].startNano = shmData->clock.nano;
-                                    processTable[openIndex].messagesSent = 0;
-                                    for (int i = 0; i < PAGE_COUNT; i++) {
-                                        processTable[openIndex].pageTable[i] = -1;
-                                    }
-                                    //initialize page tables
-                                    for (int i = 0; i < PAGE_COUNT; ++i) {
-                                        processTable[openIndex].pageTable[i] = -1;
-                                    }
-                                    //increment launchedChildren
-                                    launchedChildren++;
-                                    //update last child launch time
-                                    lastLaunchSec = shmData->clock.seconds;
-                                    lastLaunchNano = shmData->clock.nano;
-                                    outputProcessTable();
-                                }
-                            }
-                        }
-                    }
-                }
-        }
-
-        // CLEAN UP SHARED MEMORY
-        shmdt(shmData);
-        shmctl(shmid, IPC_RMID, NULL);
-        // CLEAN UP MESSAGE QUEUE
-        if (msgctl(msqid, IPC_RMID, NULL) == -1) {
-            cerr << "ERROR: msgctl failed in oss \n";
-            exit(1);
-        }
-
-        // OUTPUT SUMMARY
-        cout << "PROGRAM SUMMARY" << endl;
-        cout << "Processes Launched: " << proc << endl;
-        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-            file << "PROGRAM SUMMARY" << endl;
-            logLinesWritten++;
-            file << "Processes Launched: " << proc << endl;
-            logLinesWritten++;
-            file << "Messages Sent: " << totalMessagesSent << endl;
-            logLinesWritten++;
-        }
-        float accessRate = (float)totalMemoryAccesses / (time(NULL) - startWallTime);
-        float faultRate = (totalMemoryAccesses > 0) ? (float)totalPageFaults / totalMemoryAccesses : 0.0f;
-        cout << "\n===PROGRAM SUMMARY===\n";
-        cout << "Processes Launched: " << launchedChildren << endl;
-        cout << "Memory Accesses: " << totalMemoryAccesses << endl;
-        cout << "Page Faults: " << totalPageFaults << endl;
-        cout << "Memory Access Rates: " << accessRate << " accesses/sec" << endl;
-        cout << "Page Fault Rate: " << faultRate << " faults/access" << endl;
-        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
-            file << "\n===PROGRAM SUMMARY===\n";
-            file << "Processes Launched: " << launchedChildren << endl;
-            file << "Memory Accesses: " << totalMemoryAccesses << endl;
-            file << "Page Faults: " << totalPageFaults << endl;
-            file << "Memory Access Rates: " << accessRate << " accesses/sec" << endl;
-            file << "Page Fault Rate: " << faultRate << " faults/access" << endl;
-            logLinesWritten += 6;
-        }
-
-
-        // CLOSE LOG FILE
-        file.close();
-
-        return 0;
-}
-
-// FUNCTION TO PRINT HELP MESSAGE/USAGE
-void printUsage() {
-    cout << "Usage: oss [-h] [-n proc] [-s simul] [-i intervalInMsToLaunchChildren]\n";
-    cout << " -h                               -> Display help message\n";
-    cout << " -n proc                          -> Total processes to launch\n";
-    cout << " -s simul                         -> Number of processes that can run simultaneously\n";
-    cout << " -i intervalInMsToLaunchChildren   -> Interval (in ms) to launch children\n";
-    cout << " -f logfile                       -> Name of file in which to write output\n";
-}
-
-// FUNCTION TO INCREMENT CLOCK
-void incrementClock() {
-    int active = countActiveChildren();
-    int msToIncrement = 250;
-    if (active > 0) {
-        msToIncrement = 250 / active;
-        shmData->clock.nano += (msToIncrement * 1000000);
-    }
-    else {
-        shmData->clock.nano += (msToIncrement * 1000000);
-    }
-    if (shmData->clock.nano >= SECOND) {
-        shmData->clock.seconds++;
-        shmData->clock.nano = shmData->clock.nano - SECOND;
-    }
-}
-
-// FUNCTION TO CLEAR PCB OF TERMINATED CHILD IN PROCESS TABLE
-void updatePCBofTerminatedChild(pid_t termPid) {
-    for (int i = 0; i < MAX_PROCS; i++) {
-        if (processTable[i].occupied == 1 && processTable[i].pid == termPid) {
-            processTable[i].occupied = 0;
-            processTable[i].pid = 0;
-            processTable[i].startSeconds = 0;
-            processTable[i].startNano = 0;
-            processTable[i].messagesSent = 0;
-            for (int j = 0; j < PAGE_COUNT; j++) {
-                processTable[i].pageTable[j] = -1;
-            }
-        }
-    }
-}
-
-// FUNCTION TO OUTPUT THE PROCESS TABLE
-void outputProcessTable() {
-    cout << "OSS PID: " << getpid() << " SysClockS: " << shmData->clock.seconds << " SysClockNano: " << shmData->clock.nano << endl;
-    cout << "Process Table:" << endl;
-    cout << setw(5) << "Entry";
-    cout << setw(10) << "Occupied";
-    cout << setw(10) << "PID";
-    cout << setw(10) << "StartS";
-    cout << setw(10) << "StartN";
-    cout << setw(10) << "Msgs Sent" << endl;
-    for (int i = 0; i < 20; i++) {
-        cout << setw(5) << i;
-        cout << setw(10) << processTable[i].occupied;
-        cout << setw(10) << processTable[i].pid;
-        cout << setw(10) << processTable[i].startSeconds;
-        cout << setw(10) << processTable[i].startNano;
-        cout << setw(10) << processTable[i].messagesSent;
-        cout << endl;
-    }
-}
-
-// FUNCTION TO HANDLE TIMEOUT SIGNAL
-void signal_handler(int sig) {
-    //send kill command to all children based on pids in proc table
-    for (int i = 0; i < 20; i++) {
-        if (processTable[i].occupied == 1 && processTable[i].pid > 0) {
-            if (kill(processTable[i].pid, SIGTERM) == 0) {
-                cout << "Successfully killed process " << processTable[i].pid << endl;
-            }
-            else {
-                cerr << "ERROR: unable to kill process " << processTable[i].pid << endl;
-            }
-        }
-        processTable[i].occupied = 0;
-        processTable[i].pid = 0;
-        processTable[i].startSeconds = 0;
-        processTable[i].startNano = 0;
-    }
-
-    cout << "Active children at alarm time: " << countActiveChildren() << endl;
-
-    //free shm and message queue then exit
-    msgctl(msqid, IPC_RMID, NULL);
-    shmdt(shmData);
-    shmctl(shmid, IPC_RMID, NULL);
-    exit(1);
-}
-
-// FUNCTION TO COUNT THE ACTIVE CHILDREN IN THE SYSTEM
-int countActiveChildren() {
-    int activeChildCount = 0;
-    for (int i = 0; i < 20; i++) {
-        if (processTable[i].occupied == 1) {
-            activeChildCount++;
-        }
-    }
-    return activeChildCount;
-}
-
-// FUNCTION TO CHECK IF THERE IS AN OPEN SPOT IN THE PROCESS TABLE
-int openSpaceInTable() {
-    for (int i = 0; i < 20; i++) {
-        if (processTable[i].occupied == 0) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-// FUNCTION TO CHECK IF IT IS TIME TO LAUNCH A NEW PROCESS
-bool timeToLaunchProcess(int lastChildLaunchTimeSec, int lastChildLaunchTimeNano, int launchInterval) {
-    int lastChildLaunchTimeMs = (lastChildLaunchTimeSec * 1000) + (lastChildLaunchTimeNano / 1000000);
-    int currentTimeMs = (shmData->clock.seconds * 1000) + (shmData->clock.nano / 1000000);
-    return ((currentTimeMs - lastChildLaunchTimeMs) >= launchInterval);
-}
-
-// FUNCTION TO FIND A SPECIFIC PROCESS IN THE PROCESS TABLE
-int findProcessIndex(pid_t pid) {
-    for (int i = 0; i < 20; i++) {
-        if (processTable[i].occupied && processTable[i].pid == pid) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-// FUNCTION TO OUTPUT THE FRAME TABLE INFORMATION
-void outputFrameTable(ofstream& file) {
-    cout << "\nCurrent memory layout at time " << shmData->clock.seconds << ":" << shmData->clock.nano << " is:\n";
-    cout << setw(8) << "Frame" << setw(10) << "PID" << setw(10) << "Page" << setw(10) << "Dirty" << setw(15) << "LastRefS" << setw(15) << "LastRefNano" << endl;
-
-    file << "\nCurrent memory layout at time " << shmData->clock.seconds << ":" << shmData->clock.nano << " is:\n";
-    file << setw(8) << "Frame" << setw(10) << "PID" << setw(10) << "Page" << setw(10) << "Dirty" << setw(15) << "LastRefS" << setw(15) << "LastRefNano" << endl;
-    logLinesWritten += 2;
-    for (int i = 0; i < FRAME_COUNT; ++i) {
-        if (frames[i].occupied) {
-            cout << setw(8) << i << setw(10) << frames[i].pid << setw(10) << frames[i].pageNumber << setw(10) << frames[i].dirty << setw(15) << frames[i].lastRefSec << setw(15) << frames[i].lastRefNano << endl;
-            file << setw(8) << i << setw(10) << frames[i].pid << setw(10) << frames[i].pageNumber << setw(10) << frames[i].dirty << setw(15) << frames[i].lastRefSec << setw(15) << frames[i].lastRefNano << endl;
-        }
-        else {
-            cout << setw(8) << i << " (empty)\n";
-            file << setw(8) << i << " (empty)\n";
-        }
-    }
-    cout << "\nPage Tables: ";
-    file << "\nPage Tables: ";
-    logLinesWritten++;
-
-    for (int i = 0; i < MAX_PROCS; ++i) {
-        if (processTable[i].occupied) {
-            cout << "P" << i << ": [ ";
-            file << "P" << i << ": [ ";
-            for (int j = 0; j < PAGE_COUNT; ++j) {
-                cout << processTable[i].pageTable[j] << " ";
-                file << processTable[i].pageTable[j] << " ";
-            }
-            cout << "]\n";
-            file << "]\n";
-        }
-    }
-}
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      oss.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file parses command line arguments, initializes a simulated
+//                   system clock and frame table in shared memory, and creates
+//                   a process table for which it will maintain while launching workers
+//                   (see worker.cpp) within the given parameters given by the accepted
+//                   arguments.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBRARIES/NAMESPACE
+#include <iostream>
+#include <iomanip>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <time.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <signal.h>
+#include <fstream>
+#include <sstream>
+#include <queue>
+#include <deque>
+#include <climits>
+#include <cerrno>
+#include <sys/resource.h>
+#include "shm.h"
+#include "msgq.h"
+#include "zswap.h"
+#include "mrc.h"
+#include "paging.h"
+#include "profile.h"
+#include "swapfile.h"
+using namespace std;
+
+#define MAX_PROCS 20
+
+// REPLACEMENT POLICIES
+#define POLICY_LRU 0
+#define POLICY_CLOCK 1
+
+// FRAME TABLE (LIVES IN SHARED MEMORY SO WORKERS CAN SET REFERENCE/DIRTY BITS)
+Frame* frames = nullptr;
+int memoryFrames = FRAME_COUNT; // frames simulated this run (at most FRAME_COUNT)
+int activeFrames = FRAME_COUNT; // frames left after carving out the zswap pool
+int replacementPolicy = POLICY_LRU;
+LruPolicy lruPolicy;     // replacement policy hooks from paging.h
+ClockPolicy clockPolicy;
+
+// NUMA MODEL
+#define PLACE_FIRST_TOUCH 0
+#define PLACE_INTERLEAVE 1
+#define PLACE_PREFERRED 2
+#define MIGRATE_INTERVAL_NANO 100000000 // scan for hot remote pages every 100 ms
+#define MIGRATE_THRESHOLD 8             // accesses since the last scan that make a page hot
+#define MIGRATE_NANO 2000               // 2 us to copy a page between nodes
+int numaNodes = 1;
+int placementPolicy = PLACE_FIRST_TOUCH;
+int preferredNode = 0;
+int interleaveNext = 0;
+int localLatencyNano = 100;
+int remoteLatencyNano = 300;
+bool migrateHot = false;
+long long lastMigrateScan = 0;
+
+// LOG TRACKING
+int logLinesWritten = 0;
+const int MAX_LOG_LINES = 10000;
+
+// MEMORY TRACKING
+int totalMemoryAccesses = 0;
+int totalPageFaults = 0;
+time_t startWallTime;
+
+// TIER TRACKING (RAM HIT / ZSWAP LOAD / BACKING STORE LOAD)
+long long ramHits = 0;
+long long zswapLoads = 0;
+long long backingLoads = 0;
+long long ramLatencyNano = 0;
+long long zswapLatencyNano = 0;
+long long backingLatencyNano = 0;
+long long localHitsTotal = 0;
+long long localAccesses = 0;
+long long remoteAccesses = 0;
+long long localAccessNano = 0;
+long long remoteAccessNano = 0;
+long long pageMigrations = 0;
+long long iptLookups = 0;
+long long iptProbes = 0;
+long long lockRecoveries = 0; // frame locks taken back from workers that died holding them
+int iptEntries = 0;
+
+// REQUEST TRACKING (SIMULATED TIME FROM RECEIPT TO RESPONSE)
+int asyncWindow = 1;
+long long requestsCompleted = 0;
+long long requestLatencyNano = 0;
+long long faultStallNano = 0;
+long long faultsCompleted = 0;
+long long mergedFaults = 0;
+int maxInFlight = 0;
+
+// REFERENCE TRACE (EVERY ACCESS THAT REACHES OSS, FOR MISS RATIO ANALYSIS)
+vector<long long> referenceTrace;
+ofstream traceFile;
+bool analyzeRun = false;
+
+// ONLINE MISS RATIO ESTIMATES (SHARDS, PUBLISHED AT EVERY TABLE DUMP)
+double shardsRate = 0.0; // initial fraction of keys sampled, 0 = estimator off
+ShardsEstimator globalEstimator;
+ShardsEstimator processEstimators[MAX_PROCS];
+long long estimatorNano = 0; // real time spent in the estimator
+
+// EVENT LOOP (SLEEP IN msgrcv INSTEAD OF SPINNING WHEN NOTHING ELSE IS DUE)
+bool busyPoll = false;
+volatile sig_atomic_t childExited = 0;
+#define WAIT_BOUND_NANO 10000000 // longest sleep in msgrcv (10 ms), so a missed SIGCHLD can't stall oss
+timer_t waitTimer;               // one-shot timer that ends a blocking msgrcv with SIGUSR1
+long long loopPasses = 0;
+long long blockingWaits = 0;
+
+// PRE-FORKED WORKER POOL (-k): WORKERS HOST ONE SIMULATED PROCESS AFTER ANOTHER
+struct PoolWorker {
+    pid_t pid;  // real pid of the worker executable
+    bool busy;  // hosting a simulated process
+};
+bool usePool = false;
+vector<PoolWorker> workerPool;
+pid_t nextLogicalPid = 1; // simulated pids handed out in pool mode
+int poolReplacements = 0;  // pooled workers that died and were forked again
+long long launchLatencyNano = 0;
+long long launchesTimed = 0;
+double poolStartSeconds = 0.0;
+
+// BACKGROUND RECLAIM (-r low,high): KEEP FREE FRAMES BETWEEN TWO WATERMARKS SO FAULTS DON'T EVICT
+#define BACKING_STORE_NANO 14000000 // 14 ms to read or write a page on the backing store
+#define LATENCY_BUCKETS 11           // fault latency histogram: <=16us, <=64us, ... <=1s, >1s
+int lowWatermark = 0;                // 0 = reclaimer off, faults evict when memory is full
+int highWatermark = 0;
+vector<int> freeFrames[MAX_NODES];   // free frames of each node, lowest index on top
+int freeFrameCount = 0;
+long long syncReclaims = 0;          // evictions a fault had to wait for
+long long frameWaits = 0;            // faults that found every frame loading and waited for one
+long long backgroundReclaims = 0;    // evictions done ahead of time by the reclaimer
+long long reclaimWakeups = 0;
+long long syncReclaimNano = 0;
+long long backgroundReclaimNano = 0;
+vector<long long> faultLatencies;    // simulated ns from request to unblock of every fault
+
+// MULTI-CORE CPU MODEL (-C cores): RUN QUEUES, PER-CORE TLBS AND SHOOTDOWN IPIS
+#define MAX_CORES 32
+#define TLB_ENTRIES 16               // fully associative, least recently used entry replaced
+#define TLB_WALK_NANO 40             // page table walk on a TLB miss
+#define CONTEXT_SWITCH_NANO 2000     // 2 us to switch a core to another process
+#define SHOOTDOWN_NANO 500           // initiator's cost to start a shootdown and wait for acks
+#define IPI_NANO 1000                // 1 us per core interrupted to invalidate its entry
+struct TlbEntry {
+    pid_t pid;       // address space tag (like an ASID), -1 = invalid
+    long long vpn;
+    int frame;
+    long long lastUse;
+};
+struct Core {
+    deque<int> runQueue; // process table slots, front one is running
+    TlbEntry tlb[TLB_ENTRIES];
+    long long tlbHits;
+    long long tlbMisses;
+    long long contextSwitches;
+    long long ipisReceived;
+};
+int coreCount = 0; // 0 = no CPU model
+Core cores[MAX_CORES];
+long long tlbTick = 0;
+long long coreMigrations = 0;
+long long shootdowns = 0;
+long long shootdownIpis = 0;
+long long shootdownNano = 0;
+
+// PRIORITY CLASSES (-H percent) AND THE BACKING STORE QUEUE (-D depth)
+#define IO_READY 0   // unblock time known (zswap load, or backing store load in service)
+#define IO_WAITING 1 // waiting for a free backing store slot
+#define IO_NO_FRAME 2 // waiting for a frame, every frame was loading when it faulted
+int latencyPercent = 0; // share of processes launched in the latency class
+int ioDepth = 0;        // backing store loads in service at once, 0 = unlimited
+const char* CLASS_NAMES[NUM_CLASSES] = { "Latency", "Batch" };
+vector<long long> classFaultLatencies[NUM_CLASSES];
+int classProcesses[NUM_CLASSES] = { 0 };
+long long ioQueueWaitNano = 0;
+long long ioDispatched = 0;
+int maxIoWaiting = 0;
+
+// REAL DATA MODE (-d swapfile), WORKER CHECKS ARE COLLECTED AS PROCESSES EXIT
+long long dataTouches = 0;
+long long dataErrors = 0;
+long long dataRaces = 0;
+long long residentHeaderErrors = 0; // resident pages found holding another page's data at exit
+
+// PROCESS CONTROL BLOCK / PROCESS TABLE
+struct PCB {
+    int occupied;
+    pid_t pid;
+    int startSeconds;
+    int startNano;
+    int messagesSent;
+    int memoryAccesses;
+    long long localHitsSeen;
+    long long remoteHitsSeen;
+    int homeNode;          // NUMA node the process is pinned to
+    int inFlight;          // requests received but not yet answered
+    int maxInFlight;
+    long long stallNano;   // simulated time spent waiting on oss
+    pid_t workerPid;       // real pid of the worker running it (same as pid without -k)
+    struct timespec launchWall;
+    bool firstMessageSeen;
+    int core;              // core whose run queue holds it (-C)
+    int priority;          // CLASS_LATENCY or CLASS_BATCH
+    unsigned int coreMask; // cores it has run on, which may cache its translations
+};
+struct PCB processTable[20];
+
+// SHARED MEMORY
+int shmid;
+ShmSegment* shmData = nullptr;
+int msqid;
+
+// FUNCTION PROTOTYPES
+void printUsage();
+void incrementClock();
+void updatePCBofTerminatedChild(pid_t);
+void outputProcessTable();
+void signal_handler(int);
+int countActiveChildren();
+int openSpaceInTable();
+bool timeToLaunchProcess(int, int, int);
+int findProcessIndex(pid_t);
+void outputFrameTable(ofstream&);
+void addToClock(long long);
+void collectLocalHits();
+void completeRequest(int, long long);
+void unblockReadyProcesses(ofstream&, bool);
+int nodeFirstFrame(int);
+int nodeEndFrame(int);
+int memoryAccessNano(int, int);
+int findFreeFrame(int);
+void migrateHotPages(ofstream&, bool);
+void recordReference(pid_t, long long, int);
+void outputMissRatioEstimates(ofstream&);
+void sigchld_handler(int);
+void wakeup_handler(int);
+void armWaitTimer(long long);
+bool canBlockForMessage(bool);
+void startWorkerPool(int, const char*, const char*);
+pid_t forkPoolWorker(const char*, const char*);
+int idlePoolWorker();
+void assignPoolWorker(int, pid_t, int);
+void retireWorkerPool();
+pid_t replacePoolWorker(pid_t, const char*, const char*);
+void iptInsert(pid_t, long long, int);
+void iptRemove(pid_t, long long);
+void releaseFrame(int);
+int takeFreeFrame(int);
+void touchFrame(int);
+void lockFrame(int);
+void releaseFrameLocks(pid_t);
+int selectVictim();
+long long evictFrame(int, int, ofstream&, bool);
+void backgroundReclaim(ofstream&, bool);
+long long latencyPercentile(vector<long long>&, double);
+void outputFaultLatency(ostream&);
+void scheduleProcess(int);
+void unscheduleProcess(int);
+void balanceRunQueues();
+int longestRunQueue();
+long long switchToProcess(int);
+long long tlbTranslate(int, long long, int);
+void tlbFill(int, long long, int);
+long long tlbShootdown(pid_t, long long, int);
+void outputCoreSummary(ostream&);
+int frameClass(int);
+void dispatchBackingStoreIo();
+void assignWaitingFrames(ofstream&, bool);
+void outputClassSummary(ostream&);
+void outputSwapSummary(ostream&);
+
+// QUEUE STRUCTURES AND DEFINITIONS
+struct BlockedProcess {
+    pid_t pid;
+    int processIndex;
+    long long page;
+    unsigned long long address;
+    int action;
+    int frameIndex;
+    bool dirty;
+    int requestId;
+    long long requestTime;
+    int unblockAtSec;
+    int unblockAtNano;
+    int priority;
+    int ioState;        // IO_READY, IO_WAITING or IO_NO_FRAME
+    bool follower;      // joined another request's load, doesn't use a backing store slot
+    long long loadNano; // load time once the backing store starts it
+};
+vector<BlockedProcess> blockedQueue;
+void startPageLoad(BlockedProcess&, int, ofstream&, bool);
+
+// MAIN
+int main(int argc, char** argv) {
+    // VARIABLES FOR COMMAND LINE PARSING
+    int proc = 0;
+    int simul = 0;
+    int intervalInMsToLaunchChildren = 0;
+    string logfile;
+    int opt;
+    // VARIABLES FOR INTERMITTENTLY OUTPUTTING THE PROCESS TABLE
+    int lastPrintTimeSec = 0;
+    int lastPrintTimeNano = 0;
+    int elapsedPrintTimeSec;
+    int elapsedPrintTimeNano;
+    int elapsedTotalTimeNano;
+    // VARIABLES FOR LAUNCHING NEW PROCESS
+    int launchedChildren = 0;
+    int activeChildren;
+    int lastLaunchSec = 0;
+    int lastLaunchNano = 0;
+    int openIndex;
+    int status;
+    pid_t launchedPid;
+    time_t launchingStartTime = time(NULL);
+    // VARIABLES FOR MESSAGE PASSING
+    int currentIndex = 0;
+    int startIndex;
+    bool found = false;
+    msgBuffer buf;
+    pid_t childMessaging;
+    int totalMessagesSent = 0;
+    int termPid;
+    pid_t terminatedPid;
+    // VARIABLES FOR RESOURCE MANAGEMENT
+    int processIndex;
+    // VARIABLES FOR BLOCKED PROCESSES
+    int idx;
+    int rsc;
+    // VARIABLES FOR LOGFILE SETTINGS
+    bool verbose = true;
+    // VARIABLES FOR PAGING
+    unsigned long long address;
+    int action;
+    pid_t pid;
+    long long page;
+    int offset;
+    int frameIndex;
+    int delayNano;
+    int selectedFrame;
+    long long evictNano;
+    startWallTime = time(NULL);
+    int accesses;
+    float effectiveTime;
+    int normalTerminations = 0;
+    // VARIABLES FOR COMPRESSED SWAP CACHE
+    int zswapFrames = 0;
+    int loadDelayNano;
+    bool cachedDirty;
+    // VARIABLES FOR SHARED PAGE TABLES
+    bool localHits = false;
+    string policyName;
+    char slotArg[8];
+    char shmidArg[16];
+    char msqidArg[16];
+    // VARIABLES FOR ASYNCHRONOUS REQUESTS
+    long long requestTime;
+    bool merged;
+    // VARIABLES FOR NUMA MODEL
+    string placementName = "first-touch";
+    int hitNano;
+    long long timeNow;
+    // VARIABLES FOR RESULTS FILE
+    string resultsFile;
+    string workloadName = "uniform";
+    struct timespec wallStart;
+    struct timespec wallEnd;
+    double wallSeconds;
+    struct rusage usage;
+    double cpuSeconds;
+    // VARIABLES FOR EVENT LOOP
+    int msgFlags;
+    bool launchDue;
+    struct sigaction chldAction;
+    struct sigaction wakeAction;
+    struct sigevent waitEvent;
+    bool timedWait;
+    int batchMessages = 0;
+    int batchLimit;
+    struct msqid_ds queueStat;
+    // VARIABLES FOR WORKER POOL
+    int workerIndex;
+    pid_t workerPid;
+    struct timespec launchWall;
+    struct timespec firstMessageWall;
+    // VARIABLES FOR MISS RATIO ANALYSIS
+    string traceName;
+    // VARIABLES FOR PAGE PROFILE
+    string heatmapName;
+    int profilePercent = 100;
+    // VARIABLES FOR REAL DATA MODE
+    string swapName;
+
+    // INITIALIZE TIMEOUT SIGNAL
+    signal(SIGALRM, signal_handler);
+    alarm(5);
+
+    // CHILD EXITS INTERRUPT A BLOCKING msgrcv (SYSV IPC CALLS ARE NEVER RESTARTED,
+    // SA_RESTART ONLY KEEPS waitpid AND FRIENDS FROM FAILING WITH EINTR)
+    chldAction.sa_handler = sigchld_handler;
+    sigemptyset(&chldAction.sa_mask);
+    chldAction.sa_flags = SA_RESTART;
+    sigaction(SIGCHLD, &chldAction, NULL);
+
+    // A SIGCHLD LANDING AFTER canBlockForMessage CHECKS childExited BUT BEFORE msgrcv SLEEPS
+    // ISN'T SEEN, SO EVERY BLOCKING msgrcv IS BOUNDED BY A ONE-SHOT TIMER
+    wakeAction.sa_handler = wakeup_handler;
+    sigemptyset(&wakeAction.sa_mask);
+    wakeAction.sa_flags = 0;
+    sigaction(SIGUSR1, &wakeAction, NULL);
+    waitEvent.sigev_notify = SIGEV_SIGNAL;
+    waitEvent.sigev_signo = SIGUSR1;
+    waitEvent.sigev_value.sival_ptr = nullptr;
+    if (timer_create(CLOCK_MONOTONIC, &waitEvent, &waitTimer) == -1) {
+        cerr << "ERROR: Failed to create the wait timer." << endl;
+        exit(1);
+    }
+
+    // BEGIN PARSING COMMAND LINE ARGUMENTS USING FLAGS
+    while ((opt = getopt(argc, argv, "hn:s:i:f:z:lp:w:N:P:L:Mm:W:c:t:AR:Bkr:C:H:D:g:G:d:")) != -1) {
+        switch (opt) {
+        case 'h': // h - display help/usage message and exit (success)
+            printUsage();
+            return 0;
+        case 'n': // n flag - store total children to launch
+            proc = atoi(optarg);
+            break;
+        case 's': // s flag - store number of children able to run simultaneously
+            simul = atoi(optarg);
+            break;
+        case 'i': // i flag - store interval to launch children
+            intervalInMsToLaunchChildren = atoi(optarg);
+            break;
+        case 'f': // f flag - store name for output file
+            logfile = optarg;
+            break;
+        case 'z': // z flag - store number of frames given to the compressed swap cache
+            zswapFrames = atoi(optarg);
+            break;
+        case 'l': // l flag - let workers resolve page hits through the shared page tables
+            localHits = true;
+            break;
+        case 'p': // p flag - store replacement policy (lru or clock)
+            policyName = optarg;
+            break;
+        case 'w': // w flag - store how many requests a worker may have in flight
+            asyncWindow = atoi(optarg);
+            break;
+        case 'N': // N flag - store number of NUMA memory nodes
+            numaNodes = atoi(optarg);
+            break;
+        case 'P': // P flag - store page placement policy
+            placementName = optarg;
+            break;
+        case 'L': // L flag - store local,remote access latency in ns
+            if (sscanf(optarg, "%d,%d", &localLatencyNano, &remoteLatencyNano) != 2) {
+                localLatencyNano = -1;
+            }
+            break;
+        case 'M': // M flag - migrate hot remote pages to their owner's node
+            migrateHot = true;
+            break;
+        case 'm': // m flag - store number of frames to simulate
+            memoryFrames = atoi(optarg);
+            break;
+        case 'W': // W flag - store worker reference pattern
+            workloadName = optarg;
+            break;
+        case 'c': // c flag - store name of CSV file to append the run's results to
+            resultsFile = optarg;
+            break;
+        case 't': // t flag - store name of file to record the reference trace in
+            traceName = optarg;
+            break;
+        case 'A': // A flag - print the LRU/OPT miss ratio curve of this run
+            analyzeRun = true;
+            break;
+        case 'R': // R flag - store percent of pages sampled by the online miss ratio estimator
+            shardsRate = atof(optarg) / 100.0;
+            break;
+        case 'B': // B flag - busy poll the message queue (old main loop, for comparison)
+            busyPoll = true;
+            break;
+        case 'k': // k flag - keep a pool of pre-forked workers instead of fork/exec per process
+            usePool = true;
+            break;
+        case 'g': // g flag - store name of file to write the per-page heatmap to
+            heatmapName = optarg;
+            break;
+        case 'G': // G flag - store percent of pages the profiler samples
+            profilePercent = atoi(optarg);
+            break;
+        case 'C': // C flag - store number of simulated cores (per-core run queues and TLBs)
+            coreCount = atoi(optarg);
+            break;
+        case 'H': // H flag - store percent of processes launched in the latency-critical class
+            latencyPercent = atoi(optarg);
+            break;
+        case 'D': // D flag - store how many backing store loads can be in service at once
+            ioDepth = atoi(optarg);
+            break;
+        case 'd': // d flag - store name of the swap file that holds real page contents
+            swapName = optarg;
+            break;
+        case 'r': // r flag - store low,high free frame watermarks of the background reclaimer
+            if (sscanf(optarg, "%d,%d", &lowWatermark, &highWatermark) != 2) {
+                lowWatermark = -1;
+            }
+            break;
+        default: // default case - display usage and exit
+            cerr << "Usage Invalid.\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    // VALIDATING COMMAND LINE ARGUMENTS
+    if (proc <= 0 || simul <= 0 || intervalInMsToLaunchChildren <= 0) {
+        cerr << "ERROR: All arguments for flags -n, -s, and -i must be positive integers.\n";
+        printUsage();
+        return 1;
+    }
+
+    if (memoryFrames < 1 || memoryFrames > FRAME_COUNT) {
+        cerr << "ERROR: Argument for flag -m must be between 1 and " << FRAME_COUNT << ".\n";
+        printUsage();
+        return 1;
+    }
+    if (workloadName != "uniform" && workloadName != "local") {
+        cerr << "ERROR: Argument for flag -W must be uniform or local.\n";
+        printUsage();
+        return 1;
+    }
+    if (zswapFrames < 0 || zswapFrames >= memoryFrames) {
+        cerr << "ERROR: Argument for flag -z must be between 0 and " << memoryFrames - 1 << ".\n";
+        printUsage();
+        return 1;
+    }
+
+    // LOCAL HITS DON'T UPDATE LRU TIMESTAMPS, SO THEY DEFAULT TO CLOCK
+    if (policyName.empty()) {
+        policyName = localHits ? "clock" : "lru";
+    }
+    if (policyName == "lru") {
+        replacementPolicy = POLICY_LRU;
+    }
+    else if (policyName == "clock") {
+        replacementPolicy = POLICY_CLOCK;
+    }
+    else {
+        cerr << "ERROR: Argument for flag -p must be lru or clock.\n";
+        printUsage();
+        return 1;
+    }
+
+    // EVERY IN-FLIGHT FAULT PINS A LOADING FRAME, SO THE WINDOWS MUST FIT IN MEMORY
+    if (asyncWindow < 1 || asyncWindow > MAX_WINDOW || min(simul, 18) * asyncWindow > memoryFrames - zswapFrames) {
+        cerr << "ERROR: Argument for flag -w must be between 1 and " << MAX_WINDOW << ", and simul * window must not exceed the frame count.\n";
+        printUsage();
+        return 1;
+    }
+
+    // VALIDATE NUMA SETTINGS (EVERY NODE NEEDS AT LEAST ONE PAGE FRAME, OR framesPerNode IS 0)
+    if (numaNodes < 1 || numaNodes > MAX_NODES || numaNodes > memoryFrames - zswapFrames) {
+        cerr << "ERROR: Argument for flag -N must be between 1 and " << min(MAX_NODES, memoryFrames - zswapFrames)
+             << " (at most " << MAX_NODES << " nodes, and no more than the " << memoryFrames - zswapFrames << " page frames outside zswap).\n";
+        printUsage();
+        return 1;
+    }
+    if (localLatencyNano <= 0 || remoteLatencyNano <= 0) {
+        cerr << "ERROR: Argument for flag -L must be two positive latencies, e.g. 100,300.\n";
+        printUsage();
+        return 1;
+    }
+    if (placementName == "first-touch") {
+        placementPolicy = PLACE_FIRST_TOUCH;
+    }
+    else if (placementName == "interleave") {
+        placementPolicy = PLACE_INTERLEAVE;
+    }
+    else if (placementName.compare(0, 9, "preferred") == 0) {
+        placementPolicy = PLACE_PREFERRED;
+        preferredNode = (placementName.size() > 10) ? atoi(placementName.c_str() + 10) : 0;
+        if (preferredNode < 0 || preferredNode >= numaNodes) {
+            cerr << "ERROR: Preferred node must be below the node count.\n";
+            printUsage();
+            return 1;
+        }
+    }
+    else {
+        cerr << "ERROR: Argument for flag -P must be first-touch, interleave or preferred:<node>.\n";
+        printUsage();
+        return 1;
+    }
+
+    // ENFORCE MAX PROCS AS 100
+    if (proc > 100) {
+        proc = 100;
+    }
+
+    // ENFORCE MAX SIMUL PROCS AS 18
+    if (simul > 18) {
+        simul = 18;
+    }
+
+    // CREATE LOG FILE WITH SPECIFIED NAME
+    ofstream file(logfile);
+    if (!file) {
+        cerr << "ERROR: log file could not be opened" << endl;
+        exit(1);
+    }
+
+    // OPEN REFERENCE TRACE FILE
+    if (!traceName.empty()) {
+        traceFile.open(traceName);
+        if (!traceFile) {
+            cerr << "ERROR: trace file could not be opened" << endl;
+            exit(1);
+        }
+    }
+    if (shardsRate < 0.0 || shardsRate > 1.0) {
+        cerr << "ERROR: Argument for flag -R must be a percent between 0 and 100.\n";
+        printUsage();
+        return 1;
+    }
+    if (shardsRate > 0.0) {
+        shardsInit(globalEstimator, SHARDS_GLOBAL_KEYS, shardsRate);
+    }
+    if (localHits && (analyzeRun || !traceName.empty() || shardsRate > 0.0)) {
+        cout << "OSS: Warning: hits resolved by workers (-l) never reach oss and are missing from the trace" << endl;
+    }
+
+    // CARVE COMPRESSED SWAP CACHE OUT OF THE FRAME POOL
+    zswapInit(zswapFrames);
+    activeFrames = memoryFrames - zswapFrames;
+
+    if (coreCount < 0 || coreCount > MAX_CORES) {
+        cerr << "ERROR: Argument for flag -C must be between 0 and " << MAX_CORES << ".\n";
+        printUsage();
+        return 1;
+    }
+    for (int c = 0; c < coreCount; c++) {
+        for (int e = 0; e < TLB_ENTRIES; e++) {
+            cores[c].tlb[e].pid = -1;
+        }
+    }
+
+    if (latencyPercent < 0 || latencyPercent > 100 || ioDepth < 0) {
+        cerr << "ERROR: Argument for flag -H must be a percent between 0 and 100, and for flag -D a non-negative depth.\n";
+        printUsage();
+        return 1;
+    }
+
+    // PROFILE A HASH-SAMPLED SHARE OF PAGES, A REFAULT WITHIN ONE MEMORY'S WORTH OF EVICTIONS IS QUICK
+    if (profilePercent <= 0 || profilePercent > 100) {
+        cerr << "ERROR: Argument for flag -G must be a percent between 1 and 100.\n";
+        printUsage();
+        return 1;
+    }
+    if (!heatmapName.empty()) {
+        profileInit(profilePercent, activeFrames);
+    }
+
+    // RECLAIMER WATERMARKS MUST LEAVE FRAMES TO HOLD PAGES
+    if (lowWatermark < 0 || (lowWatermark > 0 && (highWatermark <= lowWatermark || highWatermark >= activeFrames))) {
+        cerr << "ERROR: Argument for flag -r must be low,high with 0 < low < high < " << activeFrames << ".\n";
+        printUsage();
+        return 1;
+    }
+
+    // REAL PAGE CONTENTS GO THROUGH THE SWAP FILE, THE COMPRESSED CACHE ONLY MODELS SYNTHETIC ONES
+    if (!swapName.empty()) {
+        if (zswapFrames > 0) {
+            cerr << "ERROR: Flags -d and -z can't be used together.\n";
+            printUsage();
+            return 1;
+        }
+        swapOpen(swapName.c_str());
+    }
+
+    // INITIALIZE SIMULATED CLOCK IN SHARED MEMORY (PRIVATE TO THIS RUN)
+    shmid = shmget(IPC_PRIVATE, BUFF_SZ, IPC_CREAT | 0600);
+    if (shmid == -1) {
+        cerr << "ERROR: Failed to create shared memory." << endl;
+        exit(1);
+    }
+    shmData = (ShmSegment*)shmat(shmid, NULL, 0);
+    if (shmData == (void*)-1) {
+        cerr << "ERROR: Failed to attach to shared memory." << endl;
+        exit(1);
+    }
+    shmData->clock.seconds = 0;
+    shmData->clock.nano = 0;
+    shmData->sharedTables = localHits ? 1 : 0;
+    shmData->asyncWindow = asyncWindow;
+    shmData->workload = (workloadName == "local") ? WORKLOAD_LOCAL : WORKLOAD_UNIFORM;
+    shmData->numaNodes = numaNodes;
+    shmData->framesPerNode = activeFrames / numaNodes;
+    shmData->dataMode = swapEnabled() ? 1 : 0;
+
+    // INITIALIZE FRAME TABLE
+    frames = shmData->frames;
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        frames[i].occupied = false;
+        frames[i].dirty = false;
+        frames[i].referenced = false;
+        frames[i].loading = false;
+        frames[i].hotness = 0;
+        frames[i].pid = -1;
+        frames[i].pageNumber = -1;
+        frames[i].lastRefSec = 0;
+        frames[i].lastRefNano = 0;
+        frames[i].lock = 0;
+    }
+
+    // EVERY PAGE FRAME STARTS ON ITS NODE'S FREE LIST
+    for (int node = 0; node < numaNodes; node++) {
+        for (int i = nodeEndFrame(node) - 1; i >= nodeFirstFrame(node); i--) {
+            freeFrames[node].push_back(i);
+        }
+    }
+    freeFrameCount = activeFrames;
+
+    // EMPTY INVERTED PAGE TABLE
+    for (int i = 0; i < IPT_SIZE; i++) {
+        shmData->pageTable[i].pid = IPT_EMPTY;
+        shmData->pageTable[i].frame = -1;
+        shmData->pageTable[i].vpn = 0;
+    }
+    for (int i = 0; i < MAX_PROCS; i++) {
+        shmData->localHits[i] = 0;
+        shmData->remoteLocalHits[i] = 0;
+        shmData->dataTouches[i] = 0;
+        shmData->dataErrors[i] = 0;
+        shmData->dataRaces[i] = 0;
+    }
+
+    // INITIALIZE MESSAGE PASSING (PRIVATE QUEUE SO SEVERAL RUNS CAN SHARE A MACHINE)
+    if ((msqid = msgget(IPC_PRIVATE, PERMS | IPC_CREAT)) == -1) { //create msgq
+        cerr << "ERROR: msgget in oss \n";
+        exit(1);
+    }
+    snprintf(shmidArg, sizeof(shmidArg), "%d", shmid);
+    snprintf(msqidArg, sizeof(msqidArg), "%d", msqid);
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+
+    // START ONE POOLED WORKER PER SIMULTANEOUS PROCESS
+    if (usePool) {
+        startWorkerPool(simul, shmidArg, msqidArg);
+        clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+        poolStartSeconds = (wallEnd.tv_sec - wallStart.tv_sec) + (wallEnd.tv_nsec - wallStart.tv_nsec) / 1e9;
+    }
+
+    //---------------------------------------------------------------
+    // ENTER LOOP TO MAINTAIN CLOCK/PROCESS TABLE AND LAUNCH CHILDREN
+    while (launchedChildren < proc || countActiveChildren() > 0) {
+        incrementClock();
+        collectLocalHits();
+        balanceRunQueues();
+        loopPasses++;
+        //SLEEP UNTIL THE NEXT MESSAGE IF NOTHING ELSE CAN HAPPEN BEFORE IT
+        launchDue = launchedChildren < proc && countActiveChildren() < simul && openSpaceInTable() >= 0 && (!usePool || idlePoolWorker() != -1)
+                    && timeToLaunchProcess(lastLaunchSec, lastLaunchNano, intervalInMsToLaunchChildren);
+        msgFlags = canBlockForMessage(launchDue) ? 0 : IPC_NOWAIT;
+        timedWait = (msgFlags == 0);
+        if (timedWait) {
+            blockingWaits++;
+            armWaitTimer(WAIT_BOUND_NANO);
+        }
+        //HANDLE RECEIVED MESSAGES AND PAGING
+        batchLimit = INT_MAX;
+        while (batchMessages < batchLimit && msgrcv(msqid, &buf, sizeof(msgBuffer), -OSS_MTYPE_BATCH, msgFlags) != -1) {
+            msgFlags = IPC_NOWAIT;
+            //THE BATCH IS WHAT WAS QUEUED WHEN IT STARTED, LATER MESSAGES WAIT FOR THE NEXT PASS
+            if (batchMessages == 0 && msgctl(msqid, IPC_STAT, &queueStat) == 0) {
+                batchLimit = 1 + queueStat.msg_qnum;
+            }
+            address = buf.address;
+            action = buf.action;
+            pid = buf.pid;
+            page = SimGeometry::page(address);
+            offset = SimGeometry::offset(address);
+            processIndex = findProcessIndex(buf.pid);
+            if (processIndex == -1) {
+                //stale message from a process already reaped
+                cout << "OSS: Ignoring message from PID " << buf.pid << " (not in process table)" << endl;
+                continue;
+            }
+            if (!processTable[processIndex].firstMessageSeen) {
+                //LAUNCH LATENCY = REAL TIME FROM LAUNCH DECISION TO THE PROCESS' FIRST MESSAGE
+                clock_gettime(CLOCK_MONOTONIC, &firstMessageWall);
+                launchLatencyNano += (firstMessageWall.tv_sec - processTable[processIndex].launchWall.tv_sec) * SECOND
+                                     + (firstMessageWall.tv_nsec - processTable[processIndex].launchWall.tv_nsec);
+                launchesTimed++;
+                processTable[processIndex].firstMessageSeen = true;
+            }
+            frameIndex = iptLookup(shmData, pid, page, &iptProbes);
+            iptLookups++;
+            requestTime = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
+            if (buf.status != -1) {
+                processTable[processIndex].inFlight++;
+                recordReference(pid, page, action);
+                //THE REQUEST RUNS ON THE PROCESS' CORE, SWITCHING TO IT IF ANOTHER PROCESS WAS RUNNING
+                addToClock(switchToProcess(processIndex));
+                processTable[processIndex].maxInFlight = max(processTable[processIndex].maxInFlight, processTable[processIndex].inFlight);
+                maxInFlight = max(maxInFlight, processTable[processIndex].inFlight);
+            }
+
+            cout << "OSS: P" << processIndex << " requesting " << (action == 0 ? "read" : "write") << " of address " << address << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
+            if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                file << "OSS: P" << processIndex << " requesting " << (action == 0 ? "read" : "write") << " of address " << address << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
+                logLinesWritten++;
+            }
+            if (buf.status == -1) {
+                //TERMINATION MESSAGE CARRIES NO MEMORY ACCESS
+            }
+            else if (frameIndex != -1 && frames[frameIndex].loading && frames[frameIndex].pid == pid && frames[frameIndex].pageNumber == page) {
+                //PAGE LOAD ALREADY IN FLIGHT - WAIT ON THE SAME LOAD
+                merged = false;
+                for (size_t i = 0; i < blockedQueue.size() && !merged; i++) {
+                    if (blockedQueue[i].frameIndex == frameIndex && blockedQueue[i].pid == pid) {
+                        BlockedProcess bp = blockedQueue[i];
+                        bp.follower = true;
+                        bp.address = address;
+                        bp.action = action;
+                        bp.dirty = (action == 1);
+                        bp.requestId = buf.requestId;
+                        bp.requestTime = requestTime;
+                        blockedQueue.push_back(bp);
+                        merged = true;
+                    }
+                }
+                totalMemoryAccesses++;
+                processTable[processIndex].memoryAccesses++;
+                mergedFaults++;
+                cout << "OSS: Address " << address << " of P" << processIndex << " is already being loaded into frame " << frameIndex << ", waiting on that load" << endl;
+                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                    file << "OSS: Address " << address << " of P" << processIndex << " is already being loaded into frame " << frameIndex << ", waiting on that load" << endl;
+                    logLinesWritten++;
+                }
+            }
+            else if (frameIndex != -1 && frames[frameIndex].occupied && frames[frameIndex].pid == pid && frames[frameIndex].pageNumber == page) {
+                //PAGE ALREADY IN MEMORY
+                touchFrame(frameIndex);
+                if (action == 1) {
+                    __atomic_store_n(&frames[frameIndex].dirty, true, __ATOMIC_RELAXED);
+                }
+                __atomic_fetch_add(&frames[frameIndex].hotness, 1, __ATOMIC_RELAXED);
+                hitNano = memoryAccessNano(processIndex, frameIndex);
+                totalMemoryAccesses++;
+                processTable[processIndex].memoryAccesses++;
+                ramHits++;
+                ramLatencyNano += hitNano;
+
+                //INCREMENT CLOCK (ADDRESS TRANSLATION, THEN LOCAL OR REMOTE NODE ACCESS)
+                addToClock(tlbTranslate(processIndex, page, frameIndex));
+                addToClock(hitNano);
+
+                //SEND RESPONSE TO WORKER
+                buf.mtype = WORKER_MTYPE(processTable[processIndex].workerPid);
+                buf.status = 0;
+                buf.frame = frameIndex;
+                cout << "OSS page hit for P" << processIndex << ", frame " << frameIndex << ". Sending response.\n";
+                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                    file << "OSS: page hit for P" << processIndex << ", frame " << frameIndex << ". Sending response.\n";
+                    logLinesWritten++;
+                }
+                if (sendMessage(msqid, &buf) == -1) {
+                    cerr << "OSS: msgsnd response failed\n";
+                    exit(1);
+                }
+                completeRequest(processIndex, requestTime);
+
+                cout << "OSS: Address " << address << " in frame " << frameIndex << ", giving data to P" << processIndex << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
+                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                    file << "OSS: Address " << address << " in frame " << frameIndex << ", giving data to P" << processIndex << " at time " << shmData->clock.seconds << ":" << shmData->clock.nano << endl;
+                    logLinesWritten++;
+                }
+            }
+            else {
+                //PAGE FAULT
+                profileFault(pid, page);
+                cout << "OSS: Address " << address << " is not in a frame, pagefault" << endl;
+                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                    file << "OSS: Address " << address << " is not in a frame, pagefault" << endl;
+                    logLinesWritten++;
+                }
+                delayNano = BACKING_STORE_NANO;
+
+                //CHECK COMPRESSED SWAP CACHE BEFORE GOING TO THE BACKING STORE
+                cachedDirty = false;
+                if (zswapEnabled() && zswapLoad(pid, page, cachedDirty)) {
+                    loadDelayNano = ZSWAP_LOAD_NANO;
+                    zswapLoads++;
+                    zswapLatencyNano += loadDelayNano;
+                    cout << "OSS: Page " << page << " of P" << processIndex << " found in zswap pool, decompressing" << endl;
+                    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                        file << "OSS: Page " << page << " of P" << processIndex << " found in zswap pool, decompressing" << endl;
+                        logLinesWritten++;
+                    }
+                }
+                else {
+                    loadDelayNano = delayNano;
+                    backingLoads++;
+                    backingLatencyNano += loadDelayNano;
+                }
+                addToClock(loadDelayNano);
+                totalMemoryAccesses++;
+                totalPageFaults++;
+
+                //TAKE A FREE FRAME, PREFERRING THE NODE CHOSEN BY THE PLACEMENT POLICY
+                selectedFrame = findFreeFrame(processIndex);
+
+                if (selectedFrame == -1) {
+                    //NO FREE FRAME - THE FAULT WAITS WHILE A VICTIM IS EVICTED (SYNCHRONOUS RECLAIM)
+                    selectedFrame = selectVictim();
+                }
+                if (selectedFrame != -1 && frames[selectedFrame].occupied) {
+                    cout << "OSS: Clearing frame " << selectedFrame << " and swapping in P" << processIndex << " page " << page << endl;
+                    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                        file << "OSS: Clearing frame " << selectedFrame << " and swapping in P" << processIndex << " page " << page << endl;
+                        logLinesWritten++;
+                    }
+                    evictNano = evictFrame(selectedFrame, processTable[processIndex].core, file, verbose);
+                    addToClock(evictNano);
+                    syncReclaims++;
+                    syncReclaimNano += evictNano;
+                }
+
+                //CREATE BLOCKED MEMORY REQUEST
+                BlockedProcess bp;
+                bp.pid = pid;
+                bp.processIndex = processIndex;
+                bp.page = page;
+                bp.address = address;
+                bp.action = action;
+                bp.frameIndex = -1;
+                bp.dirty = (action == 1) || cachedDirty;
+                bp.requestId = buf.requestId;
+                bp.requestTime = requestTime;
+                bp.unblockAtSec = 0;
+                bp.unblockAtNano = 0;
+                bp.priority = processTable[processIndex].priority;
+                bp.follower = false;
+                bp.loadNano = loadDelayNano;
+                bp.ioState = IO_NO_FRAME;
+                if (selectedFrame == -1) {
+                    //EVERY FRAME IS LOADING - THE FAULT WAITS UNTIL A LOAD FINISHES AND A FRAME CAN GO
+                    frameWaits++;
+                    cout << "OSS: Every frame is loading, P" << processIndex << " waits for a frame to load page " << page << " into" << endl;
+                    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                        file << "OSS: Every frame is loading, P" << processIndex << " waits for a frame to load page " << page << " into" << endl;
+                        logLinesWritten++;
+                    }
+                }
+                else {
+                    startPageLoad(bp, selectedFrame, file, verbose);
+                }
+                blockedQueue.push_back(bp);
+                //WORKER STAYS BLOCKED UNTIL THE LOAD FINISHES (RESPONSE SENT ON UNBLOCK)
+
+                //WAKE THE RECLAIMER IF THIS FAULT TOOK THE FREE POOL BELOW THE LOW WATERMARK
+                backgroundReclaim(file, verbose);
+                        }
+
+                        //HANDLE TERMINATING PROCESSES
+                        if (buf.status == -1) {
+                            collectLocalHits();
+                            processIndex = findProcessIndex(buf.pid);
+                            accesses = processTable[processIndex].memoryAccesses;
+                            effectiveTime = accesses > 0 ? ((float)accesses * 100) / 1000000000 : 0.0f;
+                            cout << "OSS: PID " << buf.pid << " is terminating. Releasing all frames. Effective memory access time: " << effectiveTime << " sec, stalled " << processTable[processIndex].stallNano << " ns" << endl;
+                            if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                                file << "OSS: PID " << buf.pid << " terminating. Releasing all frames. Effective memory access time: " << effectiveTime << " sec" << endl;
+                                logLinesWritten++;
+                            }
+                            workerPid = processTable[processIndex].workerPid;
+                            updatePCBofTerminatedChild(buf.pid);
+                            normalTerminations++;
+                            if (usePool) {
+                                //worker goes back to the pool and waits for its next process
+                                for (PoolWorker& worker : workerPool) {
+                                    if (worker.pid == workerPid) {
+                                        worker.busy = false;
+                                    }
+                                }
+                            }
+                            else {
+                                waitpid(buf.pid, NULL, 0);
+                            }
+                        }
+                        batchMessages++;
+                }
+                if (timedWait) {
+                    armWaitTimer(0);
+                }
+
+                //EACH MESSAGE STILL COSTS A TIME SLICE, CHARGED ONCE THE BATCH IS DRAINED SO
+                //A WORKER'S LATER REQUESTS IN THE BATCH SEE ITS EARLIER FAULTS STILL LOADING
+                while (batchMessages > 0) {
+                    incrementClock();
+                    batchMessages--;
+                }
+
+                //UNBLOCK ANY READY PROCESSES
+                unblockReadyProcesses(file, verbose);
+
+                //CLEAN UP ANY TERMINATED PROCESSES
+                childExited = 0;
+                while ((terminatedPid = waitpid(-1, &status, WNOHANG)) > 0) {
+                    //a worker killed mid-access may still hold a frame lock
+                    releaseFrameLocks(terminatedPid);
+                    if (usePool) {
+                        //pooled workers only exit when retired, so this one died (a new one takes its place)
+                        cerr << "ERROR: pooled worker " << terminatedPid << " exited unexpectedly" << endl;
+                        terminatedPid = replacePoolWorker(terminatedPid, shmidArg, msqidArg);
+                        if (terminatedPid == -1) {
+                            continue;
+                        }
+                    }
+                    cout << "OSS: Detected terminated child with PID " << terminatedPid << endl;
+                    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                        file << "OSS: Detected terminated child with PID " << terminatedPid << endl;
+                        logLinesWritten++;
+                    }
+                    updatePCBofTerminatedChild(terminatedPid);
+                    normalTerminations++;
+                }
+
+                //MOVE HOT PAGES BACK TO THEIR OWNER'S NODE
+                timeNow = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
+                if (migrateHot && numaNodes > 1 && timeNow - lastMigrateScan >= MIGRATE_INTERVAL_NANO) {
+                    migrateHotPages(file, verbose);
+                    lastMigrateScan = timeNow;
+                }
+
+                //OUTPUT PROCESS TABLE EVERY HALF SECOND
+                elapsedPrintTimeSec = shmData->clock.seconds - lastPrintTimeSec;
+                elapsedPrintTimeNano = shmData->clock.nano - lastPrintTimeNano;
+                if (elapsedPrintTimeNano < 0) {
+                    elapsedPrintTimeSec = shmData->clock.seconds - lastPrintTimeSec;
+                    elapsedPrintTimeNano += SECOND;
+                }
+                elapsedTotalTimeNano = (elapsedPrintTimeSec * SECOND) + elapsedPrintTimeNano;
+                if (elapsedTotalTimeNano >= 1000000000) {
+                    outputProcessTable();
+                    outputFrameTable(file);
+                    outputMissRatioEstimates(file);
+                    lastPrintTimeSec = shmData->clock.seconds;
+                    lastPrintTimeNano = shmData->clock.nano;
+                }
+
+                // LAUNCH NEW CHILD IF WITHIN BOUNDS OF SPECIFICATIONS
+                activeChildren = countActiveChildren();
+                // CHECK IF STILL CHILDREN TO LAUNCH
+                if (launchedChildren < proc) {
+                    // CHECK IF MAX ACTIVE CHILDREN ALREADY MET
+                    if (activeChildren < simul) {
+                        // CHECK IF REQUIRED TIME HAS PASSED TO LAUNCH NEW CHILD
+                        if (timeToLaunchProcess(lastLaunchSec, lastLaunchNano, intervalInMsToLaunchChildren)) {
+                            // CHECK IF OPEN SPOT IN PROCESS TABLE
+                            openIndex = openSpaceInTable();
+                            if (openIndex >= 0 && (!usePool || idlePoolWorker() != -1)) {
+                                //CLASS IS SET BEFORE THE WORKER STARTS, IT PICKS ITS REQUEST MTYPE FROM IT
+                                processTable[openIndex].priority = ((launchedChildren * latencyPercent) % 100 < latencyPercent) ? CLASS_LATENCY : CLASS_BATCH;
+                                shmData->priority[openIndex] = processTable[openIndex].priority;
+                                classProcesses[processTable[openIndex].priority]++;
+                                clock_gettime(CLOCK_MONOTONIC, &launchWall);
+                                if (usePool) {
+                                    //hand the new process to an idle pooled worker (no fork/exec)
+                                    workerIndex = idlePoolWorker();
+                                    launchedPid = nextLogicalPid++;
+                                    assignPoolWorker(workerIndex, launchedPid, openIndex);
+                                    workerPid = workerPool[workerIndex].pid;
+                                }
+                                else {
+                                    //fork new child
+                                    launchedPid = fork();
+                                    if (launchedPid < 0) {
+                                        cerr << "ERROR: Fork failed." << endl;
+                                        exit(1);
+                                    }
+                                    //inside child
+                                    else if (launchedPid == 0) {
+                                        //exec worker - replace child, passing its process table entry
+                                        snprintf(slotArg, sizeof(slotArg), "%d", openIndex);
+                                        execlp("./worker", "worker", slotArg, shmidArg, msqidArg, (char*)nullptr);
+                                        //check for failed exec
+                                        cerr << "ERROR: Exec failed." << endl;
+                                        exit(1);
+                                    }
+                                    workerPid = launchedPid;
+                                }
+                                //inside oss
+                                //add new process info to process table
+                                processTable[openIndex].occupied = 1;
+                                processTable[openIndex].pid = launchedPid;
+                                processTable[openIndex].workerPid = workerPid;
+                                processTable[openIndex].launchWall = launchWall;
+                                processTable[openIndex].firstMessageSeen = false;
+                                processTable[openIndex].startSeconds = shmData->clock.seconds;
+                                processTable[openIndex].startNano = shmData->clock.nano;
+                                processTable[openIndex].messagesSent = 0;
+                                processTable[openIndex].memoryAccesses = 0;
+                                processTable[openIndex].localHitsSeen = 0;
+                                processTable[openIndex].remoteHitsSeen = 0;
+                                processTable[openIndex].homeNode = openIndex % numaNodes;
+                                processTable[openIndex].inFlight = 0;
+                                processTable[openIndex].maxInFlight = 0;
+                                processTable[openIndex].stallNano = 0;
+                                scheduleProcess(openIndex);
+                                if (shardsRate > 0.0) {
+                                    shardsInit(processEstimators[openIndex], SHARDS_PROCESS_KEYS, shardsRate);
+                                }
+                                shmData->localHits[openIndex] = 0;
+                                shmData->remoteLocalHits[openIndex] = 0;
+                                shmData->dataTouches[openIndex] = 0;
+                                shmData->dataErrors[openIndex] = 0;
+                                shmData->dataRaces[openIndex] = 0;
+                                //increment launchedChildren
+                                launchedChildren++;
+                                //update last child launch time
+                                lastLaunchSec = shmData->clock.seconds;
+                                lastLaunchNano = shmData->clock.nano;
+                                outputProcessTable();
+                            }
+                        }
+                    }
+                }
+        }
+
+        // SEND POOLED WORKERS HOME
+        if (usePool) {
+            retireWorkerPool();
+        }
+
+        // WRITE OUT THE LAST BATCH AND REMOVE THE SWAP FILE
+        swapClose();
+
+        // FINAL MISS RATIO ESTIMATES (READS THE CLOCK, SO BEFORE DETACHING)
+        outputMissRatioEstimates(file);
+
+        // CLEAN UP SHARED MEMORY
+        shmdt(shmData);
+        shmctl(shmid, IPC_RMID, NULL);
+        // CLEAN UP MESSAGE QUEUE
+        if (msgctl(msqid, IPC_RMID, NULL) == -1) {
+            cerr << "ERROR: msgctl failed in oss \n";
+            exit(1);
+        }
+
+        // OUTPUT SUMMARY
+        cout << "PROGRAM SUMMARY" << endl;
+        cout << "Processes Launched: " << proc << endl;
+        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+            file << "PROGRAM SUMMARY" << endl;
+            logLinesWritten++;
+            file << "Processes Launched: " << proc << endl;
+            logLinesWritten++;
+            file << "Messages Sent: " << totalMessagesSent << endl;
+            logLinesWritten++;
+        }
+        float accessRate = (float)totalMemoryAccesses / (time(NULL) - startWallTime);
+        clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+        wallSeconds = (wallEnd.tv_sec - wallStart.tv_sec) + (wallEnd.tv_nsec - wallStart.tv_nsec) / 1e9;
+        getrusage(RUSAGE_SELF, &usage);
+        cpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+        float faultRate = (totalMemoryAccesses > 0) ? (float)totalPageFaults / totalMemoryAccesses : 0.0f;
+        cout << "\n===PROGRAM SUMMARY===\n";
+        cout << "Processes Launched: " << launchedChildren << endl;
+        cout << "Memory Accesses: " << totalMemoryAccesses << endl;
+        cout << "Page Faults: " << totalPageFaults << endl;
+        cout << "Memory Access Rates: " << accessRate << " accesses/sec" << endl;
+        cout << "Page Fault Rate: " << faultRate << " faults/access" << endl;
+        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+            file << "\n===PROGRAM SUMMARY===\n";
+            file << "Processes Launched: " << launchedChildren << endl;
+            file << "Memory Accesses: " << totalMemoryAccesses << endl;
+            file << "Page Faults: " << totalPageFaults << endl;
+            file << "Memory Access Rates: " << accessRate << " accesses/sec" << endl;
+            file << "Page Fault Rate: " << faultRate << " faults/access" << endl;
+            logLinesWritten += 6;
+        }
+
+        // APPEND ONE CSV ROW OF RESULTS (HEADER WHEN THE FILE IS NEW)
+        if (!resultsFile.empty()) {
+            ofstream results(resultsFile, ios::app);
+            if (!results) {
+                cerr << "ERROR: results file could not be opened" << endl;
+                exit(1);
+            }
+            if (results.tellp() == 0) {
+                results << "frames,zswapFrames,policy,workload,proc,simul,window,nodes,placement,"
+                        << "launched,accesses,faults,faultRate,zswapLoads,backingLoads,avgRequestNs,localRatio,wallSec,ossCpuSec,pool,launchUs,churnPerSec,syncReclaims,bgReclaims,faultP99Us,cores,shootdowns,ipis,latencyPct,ioDepth,latencyP99Us,batchP99Us,swapWrites,swapWriteCalls,swapReads,dataErrors\n";
+            }
+            results << memoryFrames << "," << zswapFrames << "," << policyName << "," << workloadName << "," << proc << "," << simul << ","
+                    << asyncWindow << "," << numaNodes << "," << placementName << "," << launchedChildren << "," << totalMemoryAccesses << ","
+                    << totalPageFaults << "," << faultRate << "," << zswapLoads << "," << backingLoads << ","
+                    << (requestsCompleted > 0 ? requestLatencyNano / requestsCompleted : 0) << ","
+                    << (localAccesses + remoteAccesses > 0 ? (float)localAccesses / (localAccesses + remoteAccesses) : 0.0f) << ","
+                    << wallSeconds << "," << cpuSeconds << "," << (usePool ? 1 : 0) << ","
+                    << (launchesTimed > 0 ? launchLatencyNano / launchesTimed / 1000.0 : 0.0) << ","
+                    << (wallSeconds > 0 ? launchedChildren / wallSeconds : 0.0) << "," << syncReclaims << "," << backgroundReclaims << ","
+                    << latencyPercentile(faultLatencies, 99) / 1000 << "," << coreCount << "," << shootdowns << "," << shootdownIpis << ","
+                    << latencyPercent << "," << ioDepth << "," << latencyPercentile(classFaultLatencies[CLASS_LATENCY], 99) / 1000 << ","
+                    << latencyPercentile(classFaultLatencies[CLASS_BATCH], 99) / 1000 << "," << swapGetStats().pagesWritten << ","
+                    << swapGetStats().writeCalls << "," << swapGetStats().pagesRead << ","
+                    << swapGetStats().checksumErrors + swapGetStats().headerErrors + dataErrors + residentHeaderErrors << "\n";
+        }
+
+        // OUTPUT MISS RATIO CURVE (ONE STACK DISTANCE PASS + OPT PER FRAME COUNT)
+        if (analyzeRun) {
+            stringstream curve;
+            printMissRatioCurve(curve, referenceTrace, memoryFrames, max(1, memoryFrames / 16));
+            curve << "Live " << policyName << " policy: " << totalPageFaults << " faults with " << activeFrames << " frames" << endl;
+            cout << "\n" << curve.str();
+            if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                file << "\n" << curve.str();
+                logLinesWritten += 20;
+            }
+        }
+        if (shardsRate > 0.0) {
+            cout << "MRC Estimator: " << globalEstimator.sampled << " of " << globalEstimator.references << " references sampled, "
+                 << globalEstimator.lastRef.size() << " keys tracked, " << (wallSeconds > 0 ? estimatorNano / (wallSeconds * 1e7) : 0.0) << "% of oss run time" << endl;
+        }
+        if (profileEnabled()) {
+            profileWriteHeatmap(heatmapName);
+            cout << "\nPage Profile: " << profileSampledPages() << " pages sampled (" << profilePercent << "%), heatmap written to " << heatmapName << endl;
+            profilePrintPingPong(cout);
+            if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                file << "\nPage Profile: " << profileSampledPages() << " pages sampled (" << profilePercent << "%), heatmap written to " << heatmapName << endl;
+                profilePrintPingPong(file);
+                logLinesWritten += PROFILE_TOP + 3;
+            }
+        }
+        if (traceFile.is_open()) {
+            traceFile.close();
+            cout << "Reference Trace: " << referenceTrace.size() << " references written to " << traceName << endl;
+        }
+
+        // OUTPUT PER-TIER SUMMARY
+        const ZswapStats& zs = zswapGetStats();
+        long long tierLookups = zs.hits + zs.misses;
+        float zswapHitRate = (tierLookups > 0) ? (float)zs.hits / tierLookups : 0.0f;
+        float compressionRatio = (zs.compressedBytesStored > 0) ? (float)zs.rawBytesStored / zs.compressedBytesStored : 0.0f;
+        cout << "Main Loop: " << (busyPoll ? "busy poll" : "event driven") << ", " << loopPasses << " passes, " << blockingWaits << " blocking waits" << endl;
+        cout << "Worker Launch: " << (usePool ? "pre-forked pool of " + to_string(workerPool.size()) + " (" + to_string(poolReplacements) + " replaced)" : string("fork/exec")) << ", avg "
+             << (launchesTimed > 0 ? launchLatencyNano / launchesTimed / 1000.0 : 0.0) << " us from launch to first request" << endl;
+        cout << "Process Churn: " << (wallSeconds > 0 ? launchedChildren / wallSeconds : 0.0) << " simulated processes/sec"
+             << (usePool ? " (pool started in " + to_string(poolStartSeconds * 1000) + " ms)" : string("")) << endl;
+        cout << "OSS CPU Time: " << cpuSeconds << " sec of " << wallSeconds << " sec wall (" << (wallSeconds > 0 ? cpuSeconds * 100 / wallSeconds : 0.0) << "%)" << endl;
+        cout << "Request Window: " << asyncWindow << " (max in flight: " << maxInFlight << ")" << endl;
+        cout << "Avg Request Latency: " << (requestsCompleted > 0 ? requestLatencyNano / requestsCompleted : 0) << " ns" << endl;
+        cout << "Avg Fault Stall: " << (faultsCompleted > 0 ? faultStallNano / faultsCompleted : 0) << " ns (" << mergedFaults << " requests joined a load in flight)" << endl;
+        cout << "Frame Reclaim: " << (lowWatermark > 0 ? "watermarks " + to_string(lowWatermark) + "/" + to_string(highWatermark) : string("on demand")) << ", "
+             << syncReclaims << " sync evictions (avg " << (syncReclaims > 0 ? syncReclaimNano / syncReclaims : 0) << " ns charged to faults), "
+             << backgroundReclaims << " background evictions in " << reclaimWakeups << " wakeups (avg " << (backgroundReclaims > 0 ? backgroundReclaimNano / backgroundReclaims : 0) << " ns), "
+             << frameWaits << " faults waited for a frame" << endl;
+        outputFaultLatency(cout);
+        if (latencyPercent > 0 || ioDepth > 0) {
+            outputClassSummary(cout);
+        }
+        if (coreCount > 0) {
+            outputCoreSummary(cout);
+        }
+        if (!swapName.empty()) {
+            outputSwapSummary(cout);
+        }
+        cout << "NUMA Nodes: " << numaNodes << " (placement: " << placementName << ", migrations: " << pageMigrations << ")" << endl;
+        cout << "Local Accesses: " << localAccesses << " (avg " << (localAccesses > 0 ? localAccessNano / localAccesses : 0) << " ns)" << endl;
+        cout << "Remote Accesses: " << remoteAccesses << " (avg " << (remoteAccesses > 0 ? remoteAccessNano / remoteAccesses : 0) << " ns)" << endl;
+        cout << "Local Access Ratio: " << (localAccesses + remoteAccesses > 0 ? (float)localAccesses / (localAccesses + remoteAccesses) : 0.0f) << endl;
+        cout << "Replacement Policy: " << policyName << endl;
+        cout << "Hits Resolved By Workers: " << localHitsTotal << " (" << lockRecoveries << " frame locks recovered from dead workers)" << endl;
+        cout << "Inverted Page Table: " << IPT_SIZE << " slots, " << iptEntries << " mapped at exit, "
+             << (iptLookups > 0 ? (float)iptProbes / iptLookups : 0.0f) << " probes per oss lookup" << endl;
+        cout << "Frames In Use For Pages: " << activeFrames << " (zswap pool: " << zswapFrames << " frames)" << endl;
+        cout << "RAM Hits: " << ramHits << " (avg " << (ramHits > 0 ? ramLatencyNano / ramHits : 0) << " ns)" << endl;
+        cout << "zswap Loads: " << zswapLoads << " (avg " << (zswapLoads > 0 ? zswapLatencyNano / zswapLoads : 0) << " ns)" << endl;
+        cout << "Backing Store Loads: " << backingLoads << " (avg " << (backingLoads > 0 ? backingLatencyNano / backingLoads : 0) << " ns)" << endl;
+        if (zswapEnabled()) {
+            cout << "zswap Hit Rate: " << zswapHitRate << " hits/fault" << endl;
+            cout << "zswap Stores: " << zs.stores << " Rejects: " << zs.rejects << " Demotions: " << zs.demotions << " Dirty Writebacks: " << zs.dirtyWritebacks << endl;
+            cout << "zswap Compression Ratio: " << compressionRatio << endl;
+        }
+        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+            file << "Main Loop: " << (busyPoll ? "busy poll" : "event driven") << ", " << loopPasses << " passes, " << blockingWaits << " blocking waits" << endl;
+            file << "Worker Launch: " << (usePool ? "pre-forked pool of " + to_string(workerPool.size()) + " (" + to_string(poolReplacements) + " replaced)" : string("fork/exec")) << ", avg "
+                 << (launchesTimed > 0 ? launchLatencyNano / launchesTimed / 1000.0 : 0.0) << " us from launch to first request" << endl;
+            file << "Process Churn: " << (wallSeconds > 0 ? launchedChildren / wallSeconds : 0.0) << " simulated processes/sec"
+                 << (usePool ? " (pool started in " + to_string(poolStartSeconds * 1000) + " ms)" : string("")) << endl;
+            logLinesWritten += 2;
+            file << "OSS CPU Time: " << cpuSeconds << " sec of " << wallSeconds << " sec wall (" << (wallSeconds > 0 ? cpuSeconds * 100 / wallSeconds : 0.0) << "%)" << endl;
+            logLinesWritten += 2;
+            file << "Request Window: " << asyncWindow << " (max in flight: " << maxInFlight << ")" << endl;
+            file << "Avg Request Latency: " << (requestsCompleted > 0 ? requestLatencyNano / requestsCompleted : 0) << " ns" << endl;
+            file << "Avg Fault Stall: " << (faultsCompleted > 0 ? faultStallNano / faultsCompleted : 0) << " ns (" << mergedFaults << " requests joined a load in flight)" << endl;
+            logLinesWritten += 3;
+            file << "Frame Reclaim: " << (lowWatermark > 0 ? "watermarks " + to_string(lowWatermark) + "/" + to_string(highWatermark) : string("on demand")) << ", "
+                 << syncReclaims << " sync evictions (avg " << (syncReclaims > 0 ? syncReclaimNano / syncReclaims : 0) << " ns charged to faults), "
+                 << backgroundReclaims << " background evictions in " << reclaimWakeups << " wakeups (avg " << (backgroundReclaims > 0 ? backgroundReclaimNano / backgroundReclaims : 0) << " ns), "
+                 << frameWaits << " faults waited for a frame" << endl;
+            outputFaultLatency(file);
+            logLinesWritten += 3;
+            if (latencyPercent > 0 || ioDepth > 0) {
+                outputClassSummary(file);
+                logLinesWritten += NUM_CLASSES + 1;
+            }
+            if (coreCount > 0) {
+                outputCoreSummary(file);
+                logLinesWritten += 3 + coreCount;
+            }
+            if (!swapName.empty()) {
+                outputSwapSummary(file);
+                logLinesWritten += 3;
+            }
+            file << "NUMA Nodes: " << numaNodes << " (placement: " << placementName << ", migrations: " << pageMigrations << ")" << endl;
+            file << "Local Accesses: " << localAccesses << " (avg " << (localAccesses > 0 ? localAccessNano / localAccesses : 0) << " ns)" << endl;
+            file << "Remote Accesses: " << remoteAccesses << " (avg " << (remoteAccesses > 0 ? remoteAccessNano / remoteAccesses : 0) << " ns)" << endl;
+            file << "Local Access Ratio: " << (localAccesses + remoteAccesses > 0 ? (float)localAccesses / (localAccesses + remoteAccesses) : 0.0f) << endl;
+            logLinesWritten += 4;
+            file << "Replacement Policy: " << policyName << endl;
+            file << "Hits Resolved By Workers: " << localHitsTotal << " (" << lockRecoveries << " frame locks recovered from dead workers)" << endl;
+            file << "Inverted Page Table: " << IPT_SIZE << " slots, " << iptEntries << " mapped at exit, "
+                 << (iptLookups > 0 ? (float)iptProbes / iptLookups : 0.0f) << " probes per oss lookup" << endl;
+            logLinesWritten += 3;
+            file << "Frames In Use For Pages: " << activeFrames << " (zswap pool: " << zswapFrames << " frames)" << endl;
+            file << "RAM Hits: " << ramHits << " (avg " << (ramHits > 0 ? ramLatencyNano / ramHits : 0) << " ns)" << endl;
+            file << "zswap Loads: " << zswapLoads << " (avg " << (zswapLoads > 0 ? zswapLatencyNano / zswapLoads : 0) << " ns)" << endl;
+            file << "Backing Store Loads: " << backingLoads << " (avg " << (backingLoads > 0 ? backingLatencyNano / backingLoads : 0) << " ns)" << endl;
+            logLinesWritten += 4;
+            if (zswapEnabled()) {
+                file << "zswap Hit Rate: " << zswapHitRate << " hits/fault" << endl;
+                file << "zswap Stores: " << zs.stores << " Rejects: " << zs.rejects << " Demotions: " << zs.demotions << " Dirty Writebacks: " << zs.dirtyWritebacks << endl;
+                file << "zswap Compression Ratio: " << compressionRatio << endl;
+                logLinesWritten += 3;
+            }
+        }
+
+
+        // CLOSE LOG FILE
+        file.close();
+
+        return 0;
+}
+
+// FUNCTION TO PRINT HELP MESSAGE/USAGE
+void printUsage() {
+    cout << "Usage: oss [-h] [-n proc] [-s simul] [-i intervalInMsToLaunchChildren] [-f logfile] [-z zswapFrames] [-l] [-p policy] [-w window]\n";
+    cout << "           [-N nodes] [-P placement] [-L local,remote] [-M] [-m frames] [-W workload] [-c results.csv] [-t trace] [-A] [-R percent] [-B] [-k]\n";
+    cout << "           [-r low,high] [-C cores] [-H percent] [-D depth] [-g heatmap.csv] [-G percent] [-d swapfile]\n";
+    cout << " -h                               -> Display help message\n";
+    cout << " -n proc                          -> Total processes to launch\n";
+    cout << " -s simul                         -> Number of processes that can run simultaneously\n";
+    cout << " -i intervalInMsToLaunchChildren   -> Interval (in ms) to launch children\n";
+    cout << " -f logfile                       -> Name of file in which to write output\n";
+    cout << " -z zswapFrames                   -> Frames carved from memory for the compressed swap cache (default 0)\n";
+    cout << " -l                               -> Workers resolve page hits through shared page tables\n";
+    cout << " -p policy                        -> Replacement policy: lru or clock (default lru, clock with -l)\n";
+    cout << " -w window                        -> Requests each worker may have in flight (default 1)\n";
+    cout << " -N nodes                         -> NUMA memory nodes to split the frames into (default 1)\n";
+    cout << " -P placement                     -> first-touch, interleave or preferred:<node> (default first-touch)\n";
+    cout << " -L local,remote                  -> Local and remote node access latency in ns (default 100,300)\n";
+    cout << " -M                               -> Migrate hot remote pages to their owner's node\n";
+    cout << " -m frames                        -> Frames of memory to simulate (default " << FRAME_COUNT << ")\n";
+    cout << " -W workload                      -> Worker reference pattern: uniform or local (default uniform)\n";
+    cout << " -c results.csv                   -> Append a CSV row of this run's results to the file\n";
+    cout << " -t trace                         -> Record every reference oss handles (pid page action per line)\n";
+    cout << " -A                               -> Print the LRU and OPT miss ratio curve of this run\n";
+    cout << " -R percent                       -> Keep sampled miss ratio estimates, starting at this percent of pages\n";
+    cout << " -B                               -> Busy poll the message queue instead of sleeping in msgrcv\n";
+    cout << " -k                               -> Reuse a pool of pre-forked workers instead of fork/exec per process\n";
+    cout << " -r low,high                      -> Reclaim in the background when free frames drop below low, up to high\n";
+    cout << " -C cores                         -> Simulated cores with their own run queues and TLBs (default 0, off)\n";
+    cout << " -H percent                       -> Percent of processes launched in the latency-critical class (default 0)\n";
+    cout << " -D depth                         -> Backing store loads in service at once, served by class (default 0, unlimited)\n";
+    cout << " -g heatmap.csv                   -> Profile pages, write a per-page heatmap and list ping-pong pages\n";
+    cout << " -G percent                       -> Percent of pages the profiler samples (default 100)\n";
+    cout << " -d swapfile                      -> Frames hold real page contents, swapped through this new file (not with -z)\n";
+}
+
+// FUNCTION TO INCREMENT CLOCK
+void incrementClock() {
+    int active = countActiveChildren();
+    int msToIncrement = 250;
+    //WITH THE CPU MODEL ONLY PROCESSES SHARING A CORE SPLIT THE SLICE
+    if (coreCount > 0 && active > 0) {
+        active = max(longestRunQueue(), 1);
+    }
+    if (active > 0) {
+        msToIncrement = 250 / active;
+        shmData->clock.nano += (msToIncrement * 1000000);
+    }
+    else {
+        shmData->clock.nano += (msToIncrement * 1000000);
+    }
+    if (shmData->clock.nano >= SECOND) {
+        shmData->clock.seconds++;
+        shmData->clock.nano = shmData->clock.nano - SECOND;
+    }
+}
+
+// FUNCTION TO RECORD ONE REFERENCE FOR THE TRACE FILE AND MISS RATIO ANALYSIS
+void recordReference(pid_t pid, long long page, int action) {
+    profileAccess(pid, page);
+    if (traceFile.is_open()) {
+        traceFile << pid << " " << page << " " << action << "\n";
+    }
+    if (analyzeRun || traceFile.is_open()) {
+        referenceTrace.push_back(referenceKey(pid, page));
+    }
+    if (shardsRate > 0.0) {
+        struct timespec before;
+        struct timespec after;
+        clock_gettime(CLOCK_MONOTONIC, &before);
+        shardsReference(globalEstimator, referenceKey(pid, page));
+        shardsReference(processEstimators[findProcessIndex(pid)], referenceKey(pid, page));
+        clock_gettime(CLOCK_MONOTONIC, &after);
+        estimatorNano += (after.tv_sec - before.tv_sec) * SECOND + (after.tv_nsec - before.tv_nsec);
+    }
+}
+
+// FUNCTION TO OUTPUT THE ESTIMATED MISS RATIO OF EACH PROCESS AND THE SYSTEM AT 8..256 FRAMES
+void outputMissRatioEstimates(ofstream& file) {
+    if (shardsRate <= 0.0) {
+        return;
+    }
+    cout << "\nEstimated LRU miss ratio at time " << shmData->clock.seconds << ":" << shmData->clock.nano << " (frames across):\n";
+    file << "\nEstimated LRU miss ratio at time " << shmData->clock.seconds << ":" << shmData->clock.nano << " (frames across):\n";
+    cout << setw(8) << "Proc" << setw(8) << "PID" << setw(8) << "Refs" << setw(16) << "";
+    file << setw(8) << "Proc" << setw(8) << "PID" << setw(8) << "Refs" << setw(16) << "";
+    for (int frameCount = 8; frameCount <= FRAME_COUNT; frameCount *= 2) {
+        cout << setw(8) << frameCount;
+        file << setw(8) << frameCount;
+    }
+    cout << "\n" << setw(8) << "All" << setw(8) << "" << setw(8) << globalEstimator.references << setw(16) << "";
+    file << "\n" << setw(8) << "All" << setw(8) << "" << setw(8) << globalEstimator.references << setw(16) << "";
+    cout << fixed << setprecision(3);
+    file << fixed << setprecision(3);
+    for (int frameCount = 8; frameCount <= FRAME_COUNT; frameCount *= 2) {
+        cout << setw(8) << shardsMissRatio(globalEstimator, frameCount);
+        file << setw(8) << shardsMissRatio(globalEstimator, frameCount);
+    }
+    cout << "\n";
+    file << "\n";
+    logLinesWritten += 3;
+    for (int i = 0; i < MAX_PROCS; ++i) {
+        if (processTable[i].occupied) {
+            cout << setw(7) << "P" << i << setw(8) << processTable[i].pid << setw(8) << processEstimators[i].references << setw(16) << "";
+            file << setw(7) << "P" << i << setw(8) << processTable[i].pid << setw(8) << processEstimators[i].references << setw(16) << "";
+            for (int frameCount = 8; frameCount <= FRAME_COUNT; frameCount *= 2) {
+                cout << setw(8) << shardsMissRatio(processEstimators[i], frameCount);
+                file << setw(8) << shardsMissRatio(processEstimators[i], frameCount);
+            }
+            cout << "\n";
+            file << "\n";
+            logLinesWritten++;
+        }
+    }
+    cout.unsetf(ios::fixed);
+    file.unsetf(ios::fixed);
+    cout << setprecision(6);
+    file << setprecision(6);
+}
+
+// FUNCTION TO NOTE A CHILD EXIT (THE INTERRUPTED msgrcv WAKES THE MAIN LOOP)
+void sigchld_handler(int sig) {
+    (void)sig;
+    childExited = 1;
+}
+
+// FUNCTION TO END A BLOCKING msgrcv WHEN THE WAIT TIMER FIRES (NOTHING ELSE TO DO)
+void wakeup_handler(int sig) {
+    (void)sig;
+}
+
+// FUNCTION TO ARM THE ONE-SHOT WAIT TIMER (0 DISARMS IT)
+void armWaitTimer(long long nano) {
+    struct itimerspec wait = {};
+    wait.it_value.tv_sec = nano / SECOND;
+    wait.it_value.tv_nsec = nano % SECOND;
+    timer_settime(waitTimer, 0, &wait, NULL);
+}
+
+// FUNCTION TO CHECK IF OSS MAY SLEEP IN msgrcv
+// a worker with nothing in flight always sends again (a request or its termination),
+// so the wait ends; nothing else may be due before then
+bool canBlockForMessage(bool launchDue) {
+    long long timeNow = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
+    bool runnable = false;
+
+    if (busyPoll || launchDue || childExited) {
+        return false;
+    }
+    //loads still waiting for a backing store slot (-D) get their time at dispatch, which
+    //only follows a load in service finishing, so that load's time is the one to wait for
+    for (const BlockedProcess& bp : blockedQueue) {
+        if (bp.ioState == IO_READY && (long long)bp.unblockAtSec * SECOND + bp.unblockAtNano <= timeNow) {
+            return false;
+        }
+    }
+    for (int i = 0; i < MAX_PROCS; i++) {
+        if (processTable[i].occupied && processTable[i].inFlight == 0) {
+            runnable = true;
+        }
+    }
+    return runnable;
+}
+
+// FUNCTION TO FORK AND EXEC THE POOLED WORKERS (SLOT -1 = WAIT FOR ASSIGNMENTS)
+void startWorkerPool(int size, const char* shmidArg, const char* msqidArg) {
+    for (int i = 0; i < size; i++) {
+        workerPool.push_back({ forkPoolWorker(shmidArg, msqidArg), false });
+    }
+}
+
+// FUNCTION TO FORK ONE POOLED WORKER (SLOT -1), RETURNS ITS PID
+pid_t forkPoolWorker(const char* shmidArg, const char* msqidArg) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        cerr << "ERROR: Fork failed." << endl;
+        exit(1);
+    }
+    else if (pid == 0) {
+        execlp("./worker", "worker", "-1", shmidArg, msqidArg, (char*)nullptr);
+        cerr << "ERROR: Exec failed." << endl;
+        exit(1);
+    }
+    return pid;
+}
+
+// FUNCTION TO FIND AN IDLE POOLED WORKER, -1 IF ALL ARE BUSY
+int idlePoolWorker() {
+    for (size_t i = 0; i < workerPool.size(); i++) {
+        if (!workerPool[i].busy) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// FUNCTION TO HAND A NEW SIMULATED PROCESS (LOGICAL PID AND TABLE SLOT) TO A POOLED WORKER
+void assignPoolWorker(int workerIndex, pid_t logicalPid, int slot) {
+    msgBuffer buf;
+    buf.mtype = WORKER_MTYPE(workerPool[workerIndex].pid);
+    buf.pid = logicalPid;
+    buf.address = slot;
+    buf.action = 0;
+    buf.status = MSG_ASSIGN;
+    buf.requestId = -1;
+    if (sendMessage(msqid, &buf) == -1) {
+        cerr << "ERROR: msgsnd assignment failed\n";
+        exit(1);
+    }
+    workerPool[workerIndex].busy = true;
+}
+
+// FUNCTION TO TELL EVERY POOLED WORKER TO EXIT AND REAP IT
+void retireWorkerPool() {
+    msgBuffer buf;
+    for (PoolWorker& worker : workerPool) {
+        buf.mtype = WORKER_MTYPE(worker.pid);
+        buf.pid = 0;
+        buf.status = MSG_RETIRE;
+        buf.requestId = -1;
+        if (sendMessage(msqid, &buf) == -1) {
+            cerr << "ERROR: msgsnd retire failed\n";
+            exit(1);
+        }
+    }
+    for (PoolWorker& worker : workerPool) {
+        waitpid(worker.pid, NULL, 0);
+    }
+}
+
+// FUNCTION TO REPLACE A DEAD POOLED WORKER WITH A NEW ONE, RETURNS THE LOGICAL PID IT WAS RUNNING (OR -1)
+// the pool keeps its size, so launches never wait on workers that are gone
+pid_t replacePoolWorker(pid_t workerPid, const char* shmidArg, const char* msqidArg) {
+    pid_t logicalPid = -1;
+    for (int i = 0; i < MAX_PROCS; i++) {
+        if (processTable[i].occupied && processTable[i].workerPid == workerPid) {
+            logicalPid = processTable[i].pid;
+        }
+    }
+    for (auto it = workerPool.begin(); it != workerPool.end(); ++it) {
+        if (it->pid == workerPid) {
+            it->pid = forkPoolWorker(shmidArg, msqidArg);
+            it->busy = false;
+            poolReplacements++;
+            break;
+        }
+    }
+    return logicalPid;
+}
+
+// FUNCTION TO MAP A PAGE TO A FRAME IN THE INVERTED PAGE TABLE (OR REPOINT AN EXISTING MAPPING)
+void iptInsert(pid_t pid, long long vpn, int frame) {
+    IptEntry* table = shmData->pageTable;
+    int slot = iptHash(pid, vpn);
+    while (table[slot].pid != IPT_EMPTY) {
+        if (table[slot].pid == pid && table[slot].vpn == vpn) {
+            __atomic_store_n(&table[slot].frame, frame, __ATOMIC_RELEASE);
+            return;
+        }
+        slot = (slot + 1) & (IPT_SIZE - 1);
+    }
+    //key fields first, pid last so a probing worker never sees a half written entry as used
+    table[slot].vpn = vpn;
+    table[slot].frame = frame;
+    __atomic_store_n(&table[slot].pid, pid, __ATOMIC_RELEASE);
+    iptEntries++;
+}
+
+// FUNCTION TO UNMAP A PAGE, SHIFTING LATER ENTRIES OF ITS CLUSTER BACK SO NO TOMBSTONE IS LEFT
+void iptRemove(pid_t pid, long long vpn) {
+    IptEntry* table = shmData->pageTable;
+    int hole = iptHash(pid, vpn);
+    int next;
+    int home;
+
+    while (table[hole].pid != pid || table[hole].vpn != vpn) {
+        if (table[hole].pid == IPT_EMPTY) {
+            return;
+        }
+        hole = (hole + 1) & (IPT_SIZE - 1);
+    }
+    next = hole;
+    while (true) {
+        next = (next + 1) & (IPT_SIZE - 1);
+        if (table[next].pid == IPT_EMPTY) {
+            break;
+        }
+        //an entry may move back only if its home slot isn't cyclically in (hole, next]
+        home = iptHash(table[next].pid, table[next].vpn);
+        if ((hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next)) {
+            continue;
+        }
+        table[hole].vpn = table[next].vpn;
+        table[hole].frame = table[next].frame;
+        __atomic_store_n(&table[hole].pid, table[next].pid, __ATOMIC_RELEASE);
+        hole = next;
+    }
+    __atomic_store_n(&table[hole].pid, IPT_EMPTY, __ATOMIC_RELEASE);
+    iptEntries--;
+}
+
+// FUNCTION TO ADVANCE THE CLOCK BY A FIXED DELAY
+void addToClock(long long nano) {
+    long long total = shmData->clock.nano + nano;
+    shmData->clock.seconds += total / SECOND;
+    shmData->clock.nano = total % SECOND;
+}
+
+// FUNCTION TO FIND THE CLASS OF A FRAME'S OWNER (BATCH IF THE OWNER IS GONE)
+int frameClass(int frame) {
+    int owner = findProcessIndex(frames[frame].pid);
+    return owner == -1 ? CLASS_BATCH : processTable[owner].priority;
+}
+
+// FUNCTION TO START WAITING BACKING STORE LOADS IN FREE QUEUE SLOTS, LATENCY CLASS FIRST
+void dispatchBackingStoreIo() {
+    long long timeNow = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
+    long long unblockTime;
+    int inService = 0;
+    int waiting = 0;
+    int next;
+    if (ioDepth == 0) {
+        return;
+    }
+    for (const BlockedProcess& bp : blockedQueue) {
+        if (!bp.follower && bp.loadNano == BACKING_STORE_NANO) {
+            if (bp.ioState == IO_READY) {
+                inService++;
+            }
+            else if (bp.ioState == IO_WAITING) {
+                waiting++;
+            }
+        }
+    }
+    maxIoWaiting = max(maxIoWaiting, waiting);
+    while (inService < ioDepth && waiting > 0) {
+        //oldest waiting load of the highest class (the queue is in arrival order)
+        next = -1;
+        for (size_t i = 0; i < blockedQueue.size(); i++) {
+            if (blockedQueue[i].ioState == IO_WAITING && !blockedQueue[i].follower &&
+                (next == -1 || blockedQueue[i].priority < blockedQueue[next].priority)) {
+                next = i;
+            }
+        }
+        //the load and every request that joined it finish together
+        unblockTime = timeNow + blockedQueue[next].loadNano;
+        ioQueueWaitNano += timeNow - blockedQueue[next].requestTime;
+        ioDispatched++;
+        for (BlockedProcess& bp : blockedQueue) {
+            if (bp.frameIndex == blockedQueue[next].frameIndex && bp.pid == blockedQueue[next].pid && bp.ioState == IO_WAITING) {
+                bp.ioState = IO_READY;
+                bp.unblockAtSec = unblockTime / SECOND;
+                bp.unblockAtNano = unblockTime % SECOND;
+            }
+        }
+        inService++;
+        waiting--;
+    }
+}
+
+// FUNCTION TO START A FAULT'S PAGE LOAD INTO A FREE (OR JUST EVICTED) FRAME
+void startPageLoad(BlockedProcess& bp, int frame, ofstream& file, bool verbose) {
+    long long unblockTime = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano + bp.loadNano;
+
+    //SCHEDULE UNBLOCK TIME
+    bp.frameIndex = frame;
+    bp.unblockAtSec = unblockTime / SECOND;
+    bp.unblockAtNano = unblockTime % SECOND;
+    //with a limited backing store queue the load waits its turn (zswap loads don't use it)
+    bp.ioState = (ioDepth > 0 && bp.loadNano == BACKING_STORE_NANO) ? IO_WAITING : IO_READY;
+    cout << "OSS: Queued page load for PID " << bp.pid << " into frame " << frame << ", will unblock at " << bp.unblockAtSec << ":" << bp.unblockAtNano << endl;
+    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+        file << "OSS: Queue page load for PID " << bp.pid << " into frame " << frame << ", will unblock at " << bp.unblockAtSec << ":" << bp.unblockAtNano << endl;
+        logLinesWritten++;
+    }
+
+    //ASSIGN FRAME TO THIS PAGE
+    frames[frame].occupied = true;
+    frames[frame].pid = bp.pid;
+    frames[frame].pageNumber = bp.page;
+    frames[frame].dirty = bp.dirty;
+    frames[frame].loading = true;
+    frames[frame].hotness = 0;
+    touchFrame(frame);
+    //FILL THE FRAME WITH THE PAGE'S REAL CONTENTS (READ FROM THE SWAP FILE OR GENERATED)
+    if (swapEnabled()) {
+        swapLoad(bp.pid, bp.page, frameBytes(shmData, frame));
+    }
+    iptInsert(bp.pid, bp.page, frame);
+    cout << "OSS: Loaded page " << bp.page << " for PID " << bp.pid << " into frame " << frame << endl;
+    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+        file << "OSS: Loaded page " << bp.page << " for PID " << bp.pid << " into frame " << frame << endl;
+        logLinesWritten++;
+    }
+}
+
+// FUNCTION TO GIVE FAULTS WAITING FOR A FRAME ONE NOW THAT LOADS HAVE FINISHED, OLDEST FIRST
+void assignWaitingFrames(ofstream& file, bool verbose) {
+    long long timeNow;
+    long long evictNano;
+    int frame;
+    for (BlockedProcess& bp : blockedQueue) {
+        if (bp.ioState != IO_NO_FRAME) {
+            continue;
+        }
+        //AN EARLIER WAITING FAULT MAY HAVE LOADED THE SAME PAGE ALREADY
+        frame = iptLookup(shmData, bp.pid, bp.page, &iptProbes);
+        iptLookups++;
+        if (frame != -1) {
+            timeNow = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
+            bp.frameIndex = frame;
+            bp.follower = true;
+            bp.ioState = IO_READY;
+            bp.unblockAtSec = timeNow / SECOND;
+            bp.unblockAtNano = timeNow % SECOND;
+            for (const BlockedProcess& leader : blockedQueue) {
+                if (leader.frameIndex == frame && leader.pid == bp.pid && !leader.follower) {
+                    bp.ioState = leader.ioState;
+                    bp.unblockAtSec = leader.unblockAtSec;
+                    bp.unblockAtNano = leader.unblockAtNano;
+                }
+            }
+            //a resident page is pinned like a loading one until the request is answered
+            frames[frame].loading = true;
+            mergedFaults++;
+            continue;
+        }
+
+        frame = findFreeFrame(bp.processIndex);
+        if (frame == -1) {
+            frame = selectVictim();
+            if (frame == -1) {
+                return;
+            }
+            cout << "OSS: Clearing frame " << frame << " and swapping in P" << bp.processIndex << " page " << bp.page << endl;
+            if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                file << "OSS: Clearing frame " << frame << " and swapping in P" << bp.processIndex << " page " << bp.page << endl;
+                logLinesWritten++;
+            }
+            evictNano = evictFrame(frame, processTable[bp.processIndex].core, file, verbose);
+            addToClock(evictNano);
+            syncReclaims++;
+            syncReclaimNano += evictNano;
+        }
+        startPageLoad(bp, frame, file, verbose);
+    }
+}
+
+// FUNCTION TO PRINT FAULT COUNTS AND LATENCY PERCENTILES OF EACH PRIORITY CLASS
+void outputClassSummary(ostream& out) {
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        out << CLASS_NAMES[c] << " Class: " << classProcesses[c] << " processes, " << classFaultLatencies[c].size() << " faults, p50 "
+            << latencyPercentile(classFaultLatencies[c], 50) / 1000 << " us, p99 " << latencyPercentile(classFaultLatencies[c], 99) / 1000 << " us" << endl;
+    }
+    out << "Backing Store Queue: " << (ioDepth > 0 ? "depth " + to_string(ioDepth) : string("unlimited")) << ", max " << maxIoWaiting
+        << " loads waiting, avg wait " << (ioDispatched > 0 ? ioQueueWaitNano / ioDispatched / 1000 : 0) << " us" << endl;
+}
+
+// FUNCTION TO OUTPUT THE REAL I/O AND COPY COSTS OF THE SWAP FILE AND THE DATA CHECKS
+void outputSwapSummary(ostream& out) {
+    const SwapStats& ss = swapGetStats();
+    long long ioNano = ss.writeNano + ss.readNano;
+    out << "Swap File: " << ss.pagesWritten << " pages written in " << ss.writeCalls << " pwritev calls (avg "
+        << (ss.writeCalls > 0 ? (float)ss.pagesWritten / ss.writeCalls : 0.0f) << " pages, " << (ss.pagesWritten > 0 ? ss.writeNano / ss.pagesWritten : 0)
+        << " ns per page), " << ss.pagesRead << " read (" << (ss.pagesRead > 0 ? ss.readNano / ss.pagesRead : 0) << " ns per page), "
+        << ss.batchHits << " loaded from the write batch, " << ss.pagesGenerated << " generated, " << ss.cleanSkips << " clean evictions skipped, "
+        << ss.slotsHigh << " slots used" << endl;
+    out << "Real Data Path: " << ss.bytesCopied / 1024 << " KB copied in memory (" << (ss.copyNano > 0 ? ss.bytesCopied * 1000.0 / ss.copyNano : 0.0)
+        << " MB/s), " << (ss.pagesWritten + ss.pagesRead) * PAGE_SIZE / 1024 << " KB of swap I/O (" << (ioNano > 0 ? (ss.pagesWritten + ss.pagesRead) * PAGE_SIZE * 1000.0 / ioNano : 0.0)
+        << " MB/s)" << endl;
+    out << "Data Integrity: " << dataTouches << " worker touches (" << dataRaces << " skipped after a late eviction), " << ss.pagesVerified
+        << " swapped pages verified at exit, " << ss.checksumErrors + ss.headerErrors + dataErrors + residentHeaderErrors << " errors ("
+        << dataErrors << " worker, " << ss.checksumErrors << " checksum, " << ss.headerErrors + residentHeaderErrors << " header)" << endl;
+}
+
+// FUNCTION TO RECORD A REFERENCE TO A FRAME THROUGH THE POLICY HOOKS
+// both policies' state is kept whatever -p says: clock falls back to LRU order, and
+// the frame table prints both
+void touchFrame(int frame) {
+    long long timeNow = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
+    lruPolicy.touch(frames[frame], timeNow);
+    clockPolicy.touch(frames[frame], timeNow);
+}
+
+// FUNCTION TO TAKE A FRAME'S OWNERSHIP LOCK, TAKING IT BACK FROM A WORKER THAT EXITED HOLDING IT
+// (WNOWAIT leaves the exited worker for the main loop to reap)
+void lockFrame(int frame) {
+    unsigned long long lockWord;
+    siginfo_t info;
+    pid_t holder;
+    while (!frameTryLock(&frames[frame], lockWord = frameLockWord(&frames[frame]), getpid())) {
+        holder = frameLockHolder(lockWord);
+        if (holder == 0) {
+            continue;
+        }
+        info.si_pid = 0;
+        if ((waitid(P_PID, holder, &info, WEXITED | WNOHANG | WNOWAIT) == 0 && info.si_pid == holder) ||
+            errno == ECHILD) {
+            frameLockRelease(&frames[frame], lockWord);
+            lockRecoveries++;
+        }
+    }
+}
+
+// FUNCTION TO RELEASE EVERY FRAME LOCK A REAPED WORKER STILL HOLDS
+void releaseFrameLocks(pid_t workerPid) {
+    unsigned long long lockWord;
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        lockWord = frameLockWord(&frames[i]);
+        if (frameLockHolder(lockWord) == workerPid && frameLockRelease(&frames[i], lockWord)) {
+            lockRecoveries++;
+        }
+    }
+}
+
+// FUNCTION TO PICK A VICTIM WITH THE ACTIVE POLICY, RETURNS -1 IF NO RESIDENT PAGE CAN BE EVICTED
+int selectVictim() {
+    int victim = -1;
+    auto residentBatch = [](int i) { return frames[i].occupied && !frames[i].loading && frameClass(i) == CLASS_BATCH; };
+    auto resident = [](int i) { return frames[i].occupied && !frames[i].loading; };
+    //batch frames get the first chance to go, then any resident page
+    if (replacementPolicy == POLICY_CLOCK) {
+        if (latencyPercent > 0) {
+            victim = clockPolicy.selectVictim(frames, activeFrames, residentBatch);
+        }
+        if (victim == -1) {
+            victim = clockPolicy.selectVictim(frames, activeFrames, resident);
+        }
+        //workers may keep setting reference bits (-l) faster than two sweeps clear them,
+        //then the oldest resident page goes
+        if (victim == -1) {
+            victim = lruPolicy.selectVictim(frames, activeFrames, resident);
+        }
+    }
+    else {
+        if (latencyPercent > 0) {
+            victim = lruPolicy.selectVictim(frames, activeFrames, residentBatch);
+        }
+        if (victim == -1) {
+            victim = lruPolicy.selectVictim(frames, activeFrames, resident);
+        }
+    }
+    return victim;
+}
+
+// FUNCTION TO WRITE OUT THE PAGE IN A FRAME AND UNMAP IT, RETURNS THE SIMULATED COST
+// the frame is left unoccupied with stale fields; the caller either reuses it or releases it
+// initiatorCore is the core doing the eviction (-1 = the background reclaimer)
+long long evictFrame(int frame, int initiatorCore, ofstream& file, bool verbose) {
+    pid_t oldPid = frames[frame].pid;
+    long long oldPage = frames[frame].pageNumber;
+    long long cost = 0;
+    int dirtyDemotions;
+    bool storedInZswap;
+
+    //HOLD THE FRAME SO NO WORKER SETS ITS BITS WHILE IT IS WRITTEN OUT
+    lockFrame(frame);
+
+    //TRY TO COMPRESS THE VICTIM INTO THE ZSWAP POOL
+    storedInZswap = zswapEnabled() && zswapStore(oldPid, oldPage, frames[frame].dirty, dirtyDemotions);
+
+    //STAGE THE REAL CONTENTS OF A DIRTY PAGE FOR THE SWAP FILE (BEFORE THE FRAME IS REUSED)
+    if (swapEnabled()) {
+        swapStore(oldPid, oldPage, frameBytes(shmData, frame), frames[frame].dirty);
+    }
+    if (storedInZswap) {
+        cout << "OSS: Compressed frame " << frame << " into zswap pool, " << dirtyDemotions << " dirty pages demoted to backing store" << endl;
+        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+            file << "OSS: Compressed frame " << frame << " into zswap pool, " << dirtyDemotions << " dirty pages demoted to backing store" << endl;
+            logLinesWritten++;
+        }
+        cost += ZSWAP_STORE_NANO + (long long)dirtyDemotions * BACKING_STORE_NANO;
+    }
+
+    //DIRTY PAGES GO TO THE BACKING STORE (SEEK AND WRITE, 14ms EACH)
+    if (frames[frame].dirty && !storedInZswap) {
+        cout << "OSS: Dirty bit of frame " << frame << " set, adding additional time to the clock" << endl;
+        cout << "OSS: Swapped out dirty frame. Adding 14ms I/O delay." << endl;
+        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+            file << "OSS: Dirty bit of frame " << frame << " set, adding additional time to the clock" << endl;
+            file << "OSS: Swapped out dirty frame. Adding 14ms I/O delay." << endl;
+            logLinesWritten += 2;
+        }
+        cost += 2 * BACKING_STORE_NANO;
+    }
+
+    //CLEAR OLD PAGE ENTRY (NO PROCESS TABLE LOOKUP NEEDED), THEN STALE TLB ENTRIES
+    profileEviction(oldPid, oldPage);
+    iptRemove(oldPid, oldPage);
+    frames[frame].occupied = false;
+    frameUnlock(&frames[frame]);
+    cost += tlbShootdown(oldPid, oldPage, initiatorCore);
+    return cost;
+}
+
+// FUNCTION TO RETURN A FRAME TO ITS NODE'S FREE LIST
+void releaseFrame(int frame) {
+    frames[frame].occupied = false;
+    frames[frame].dirty = false;
+    frames[frame].referenced = false;
+    frames[frame].loading = false;
+    frames[frame].hotness = 0;
+    frames[frame].pid = -1;
+    frames[frame].pageNumber = -1;
+    frames[frame].lastRefSec = 0;
+    frames[frame].lastRefNano = 0;
+    freeFrames[frameNode(shmData, frame)].push_back(frame);
+    freeFrameCount++;
+}
+
+// FUNCTION TO TAKE A FRAME FROM A NODE'S FREE LIST, RETURNS -1 IF THE NODE IS FULL
+int takeFreeFrame(int node) {
+    int frame;
+    if (freeFrames[node].empty()) {
+        return -1;
+    }
+    frame = freeFrames[node].back();
+    freeFrames[node].pop_back();
+    freeFrameCount--;
+    return frame;
+}
+
+// FUNCTION TO REFILL THE FREE POOL UP TO THE HIGH WATERMARK ONCE IT DROPS BELOW THE LOW ONE
+// like kswapd the reclaimer runs beside the faulting process, so its writes aren't charged to the clock
+void backgroundReclaim(ofstream& file, bool verbose) {
+    int victim;
+    int freed = 0;
+    long long cost;
+    if (lowWatermark == 0 || freeFrameCount >= lowWatermark) {
+        return;
+    }
+    reclaimWakeups++;
+    while (freeFrameCount < highWatermark) {
+        victim = selectVictim();
+        if (victim == -1) {
+            break;
+        }
+        cost = evictFrame(victim, -1, file, verbose);
+        releaseFrame(victim);
+        backgroundReclaims++;
+        backgroundReclaimNano += cost;
+        freed++;
+    }
+    cout << "OSS: Reclaimer freed " << freed << " frames, " << freeFrameCount << " free" << endl;
+    if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+        file << "OSS: Reclaimer freed " << freed << " frames, " << freeFrameCount << " free" << endl;
+        logLinesWritten++;
+    }
+}
+
+// FUNCTION TO FIND A PERCENTILE (0-100) OF A LIST OF LATENCIES (REORDERS THE LIST)
+long long latencyPercentile(vector<long long>& latencies, double percentile) {
+    size_t rank;
+    if (latencies.empty()) {
+        return 0;
+    }
+    rank = (size_t)(percentile / 100.0 * (latencies.size() - 1) + 0.5);
+    nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+    return latencies[rank];
+}
+
+// FUNCTION TO PRINT THE FAULT LATENCY PERCENTILES AND A POWER OF 4 HISTOGRAM IN us
+void outputFaultLatency(ostream& out) {
+    long long buckets[LATENCY_BUCKETS] = { 0 };
+    long long bound;
+    int b;
+    for (long long latency : faultLatencies) {
+        bound = 16000;
+        for (b = 0; b < LATENCY_BUCKETS - 1 && latency > bound; b++) {
+            bound *= 4;
+        }
+        buckets[b]++;
+    }
+    out << "Fault Latency: p50 " << latencyPercentile(faultLatencies, 50) / 1000 << " us, p90 " << latencyPercentile(faultLatencies, 90) / 1000
+        << " us, p99 " << latencyPercentile(faultLatencies, 99) / 1000 << " us, max " << latencyPercentile(faultLatencies, 100) / 1000 << " us" << endl;
+    out << "Fault Latency Histogram:";
+    bound = 16;
+    for (b = 0; b < LATENCY_BUCKETS - 1; b++) {
+        out << " <=" << bound << "us:" << buckets[b];
+        bound *= 4;
+    }
+    out << " more:" << buckets[LATENCY_BUCKETS - 1] << endl;
+}
+
+// FUNCTION TO PUT A NEW PROCESS ON THE SHORTEST RUN QUEUE
+void scheduleProcess(int processIndex) {
+    int best = 0;
+    processTable[processIndex].core = -1;
+    processTable[processIndex].coreMask = 0;
+    if (coreCount == 0) {
+        return;
+    }
+    for (int c = 1; c < coreCount; c++) {
+        if (cores[c].runQueue.size() < cores[best].runQueue.size()) {
+            best = c;
+        }
+    }
+    cores[best].runQueue.push_back(processIndex);
+    processTable[processIndex].core = best;
+    processTable[processIndex].coreMask = 1u << best;
+}
+
+// FUNCTION TO TAKE AN EXITING PROCESS OFF ITS RUN QUEUE AND DROP ITS TLB ENTRIES
+// (its address space tag is retired, so no shootdown is needed)
+void unscheduleProcess(int processIndex) {
+    deque<int>& queue = cores[max(processTable[processIndex].core, 0)].runQueue;
+    if (coreCount == 0) {
+        return;
+    }
+    queue.erase(remove(queue.begin(), queue.end(), processIndex), queue.end());
+    for (int c = 0; c < coreCount; c++) {
+        for (int e = 0; e < TLB_ENTRIES; e++) {
+            if (cores[c].tlb[e].pid == processTable[processIndex].pid) {
+                cores[c].tlb[e].pid = -1;
+            }
+        }
+    }
+    processTable[processIndex].core = -1;
+}
+
+// FUNCTION TO MOVE A WAITING PROCESS FROM THE LONGEST RUN QUEUE TO THE SHORTEST
+void balanceRunQueues() {
+    int longest = 0;
+    int shortest = 0;
+    int moved;
+    if (coreCount < 2) {
+        return;
+    }
+    for (int c = 1; c < coreCount; c++) {
+        if (cores[c].runQueue.size() > cores[longest].runQueue.size()) {
+            longest = c;
+        }
+        if (cores[c].runQueue.size() < cores[shortest].runQueue.size()) {
+            shortest = c;
+        }
+    }
+    if (cores[longest].runQueue.size() < cores[shortest].runQueue.size() + 2) {
+        return;
+    }
+    //the back of the queue is waiting, so moving it doesn't preempt anything
+    moved = cores[longest].runQueue.back();
+    cores[longest].runQueue.pop_back();
+    cores[shortest].runQueue.push_back(moved);
+    processTable[moved].core = shortest;
+    processTable[moved].coreMask |= 1u << shortest;
+    coreMigrations++;
+}
+
+// FUNCTION TO FIND THE MOST PROCESSES SHARING ONE CORE
+int longestRunQueue() {
+    size_t longest = 0;
+    for (int c = 0; c < coreCount; c++) {
+        longest = max(longest, cores[c].runQueue.size());
+    }
+    return longest;
+}
+
+// FUNCTION TO RUN A PROCESS ON ITS CORE, RETURNS THE CONTEXT SWITCH COST (0 IF ALREADY RUNNING)
+long long switchToProcess(int processIndex) {
+    if (coreCount == 0) {
+        return 0;
+    }
+    Core& core = cores[processTable[processIndex].core];
+    if (core.runQueue.front() == processIndex) {
+        return 0;
+    }
+    core.runQueue.erase(find(core.runQueue.begin(), core.runQueue.end(), processIndex));
+    core.runQueue.push_front(processIndex);
+    core.contextSwitches++;
+    return CONTEXT_SWITCH_NANO;
+}
+
+// FUNCTION TO TRANSLATE A RESIDENT PAGE THROUGH THE PROCESS' CORE TLB, RETURNS THE WALK COST ON A MISS
+long long tlbTranslate(int processIndex, long long page, int frame) {
+    if (coreCount == 0) {
+        return 0;
+    }
+    Core& core = cores[processTable[processIndex].core];
+    for (int e = 0; e < TLB_ENTRIES; e++) {
+        if (core.tlb[e].pid == processTable[processIndex].pid && core.tlb[e].vpn == page) {
+            core.tlb[e].lastUse = ++tlbTick;
+            core.tlbHits++;
+            return 0;
+        }
+    }
+    core.tlbMisses++;
+    tlbFill(processIndex, page, frame);
+    return TLB_WALK_NANO;
+}
+
+// FUNCTION TO CACHE A TRANSLATION IN THE PROCESS' CORE TLB, REPLACING THE LRU ENTRY
+void tlbFill(int processIndex, long long page, int frame) {
+    int slot = 0;
+    if (coreCount == 0) {
+        return;
+    }
+    Core& core = cores[processTable[processIndex].core];
+    for (int e = 0; e < TLB_ENTRIES; e++) {
+        if (core.tlb[e].pid == -1) {
+            slot = e;
+            break;
+        }
+        if (core.tlb[e].lastUse < core.tlb[slot].lastUse) {
+            slot = e;
+        }
+    }
+    core.tlb[slot].pid = processTable[processIndex].pid;
+    core.tlb[slot].vpn = page;
+    core.tlb[slot].frame = frame;
+    core.tlb[slot].lastUse = ++tlbTick;
+}
+
+// FUNCTION TO INVALIDATE A TRANSLATION ON EVERY CORE THE OWNER HAS RUN ON, RETURNS THE IPI COST
+// like Linux the owner's core mask is used, so cores are interrupted even if the entry was already gone
+long long tlbShootdown(pid_t pid, long long vpn, int initiatorCore) {
+    int owner = findProcessIndex(pid);
+    int targets = 0;
+    long long cost;
+    if (coreCount == 0 || owner == -1) {
+        return 0;
+    }
+    for (int c = 0; c < coreCount; c++) {
+        if (!(processTable[owner].coreMask & (1u << c))) {
+            continue;
+        }
+        for (int e = 0; e < TLB_ENTRIES; e++) {
+            if (cores[c].tlb[e].pid == pid && cores[c].tlb[e].vpn == vpn) {
+                cores[c].tlb[e].pid = -1;
+            }
+        }
+        if (c != initiatorCore) {
+            targets++;
+            cores[c].ipisReceived++;
+        }
+    }
+    if (targets == 0) {
+        return 0; // local invalidation only
+    }
+    cost = SHOOTDOWN_NANO + (long long)targets * IPI_NANO;
+    shootdowns++;
+    shootdownIpis += targets;
+    shootdownNano += cost;
+    return cost;
+}
+
+// FUNCTION TO PRINT THE CPU MODEL SUMMARY (ONE LINE PER CORE)
+void outputCoreSummary(ostream& out) {
+    long long hits = 0;
+    long long misses = 0;
+    long long switches = 0;
+    long long evictions = syncReclaims + backgroundReclaims + pageMigrations;
+    for (int c = 0; c < coreCount; c++) {
+        hits += cores[c].tlbHits;
+        misses += cores[c].tlbMisses;
+        switches += cores[c].contextSwitches;
+    }
+    out << "CPU Model: " << coreCount << " cores, " << switches << " context switches, " << coreMigrations << " run queue migrations" << endl;
+    out << "TLB: " << TLB_ENTRIES << " entries per core, " << hits << " hits, " << misses << " misses (hit rate "
+        << (hits + misses > 0 ? (float)hits / (hits + misses) : 0.0f) << ")" << endl;
+    out << "TLB Shootdowns: " << shootdowns << " for " << evictions << " evictions/migrations, " << shootdownIpis << " IPIs (avg "
+        << (shootdowns > 0 ? (float)shootdownIpis / shootdowns : 0.0f) << " per shootdown), " << shootdownNano << " ns" << endl;
+    for (int c = 0; c < coreCount; c++) {
+        out << "  Core " << c << ": " << cores[c].contextSwitches << " switches, " << cores[c].tlbHits << "/" << cores[c].tlbHits + cores[c].tlbMisses
+            << " TLB hits, " << cores[c].ipisReceived << " IPIs received" << endl;
+    }
+}
+
+// FUNCTION TO ACCOUNT FOR PAGE HITS WORKERS RESOLVED ON THEIR OWN
+void collectLocalHits() {
+    long long seen;
+    long long delta;
+    long long remoteSeen;
+    long long remoteDelta;
+    long long nano;
+    for (int i = 0; i < MAX_PROCS; i++) {
+        if (processTable[i].occupied) {
+            seen = __atomic_load_n(&shmData->localHits[i], __ATOMIC_RELAXED);
+            remoteSeen = __atomic_load_n(&shmData->remoteLocalHits[i], __ATOMIC_RELAXED);
+            delta = seen - processTable[i].localHitsSeen;
+            remoteDelta = remoteSeen - processTable[i].remoteHitsSeen;
+            if (delta > 0) {
+                nano = (delta - remoteDelta) * localLatencyNano + remoteDelta * remoteLatencyNano;
+                processTable[i].localHitsSeen = seen;
+                processTable[i].remoteHitsSeen = remoteSeen;
+                processTable[i].memoryAccesses += delta;
+                totalMemoryAccesses += delta;
+                localHitsTotal += delta;
+                ramHits += delta;
+                ramLatencyNano += nano;
+                localAccesses += delta - remoteDelta;
+                remoteAccesses += remoteDelta;
+                localAccessNano += (delta - remoteDelta) * localLatencyNano;
+                remoteAccessNano += remoteDelta * remoteLatencyNano;
+                addToClock(nano);
+            }
+        }
+    }
+}
+
+// FUNCTION TO FIND THE FIRST FRAME OF A NUMA NODE
+int nodeFirstFrame(int node) {
+    return node * shmData->framesPerNode;
+}
+
+// FUNCTION TO FIND ONE PAST THE LAST FRAME OF A NUMA NODE
+int nodeEndFrame(int node) {
+    return (node == numaNodes - 1) ? activeFrames : (node + 1) * shmData->framesPerNode;
+}
+
+// FUNCTION TO CHARGE A MEMORY ACCESS AS LOCAL OR REMOTE, RETURNS ITS LATENCY
+int memoryAccessNano(int processIndex, int frameIndex) {
+    if (frameNode(shmData, frameIndex) == processTable[processIndex].homeNode) {
+        localAccesses++;
+        localAccessNano += localLatencyNano;
+        return localLatencyNano;
+    }
+    remoteAccesses++;
+    remoteAccessNano += remoteLatencyNano;
+    return remoteLatencyNano;
+}
+
+// FUNCTION TO TAKE A FREE FRAME ON THE NODE CHOSEN BY THE PLACEMENT POLICY
+// falls back to the other nodes in order, returns -1 if memory is full
+int findFreeFrame(int processIndex) {
+    int node;
+    int tryNode;
+    int frame;
+    if (placementPolicy == PLACE_INTERLEAVE) {
+        node = interleaveNext;
+        interleaveNext = (interleaveNext + 1) % numaNodes;
+    }
+    else if (placementPolicy == PLACE_PREFERRED) {
+        node = preferredNode;
+    }
+    else {
+        node = processTable[processIndex].homeNode;
+    }
+
+    for (int n = 0; n < numaNodes; n++) {
+        tryNode = (node + n) % numaNodes;
+        frame = takeFreeFrame(tryNode);
+        if (frame != -1) {
+            return frame;
+        }
+    }
+    return -1;
+}
+
+// FUNCTION TO MOVE FREQUENTLY USED PAGES ON A REMOTE NODE TO THEIR OWNER'S NODE
+void migrateHotPages(ofstream& file, bool verbose) {
+    int owner;
+    int target;
+    int home;
+    unsigned long long lockWord;
+    for (int i = 0; i < activeFrames; i++) {
+        if (!frames[i].occupied || frames[i].loading) {
+            continue;
+        }
+        owner = findProcessIndex(frames[i].pid);
+        if (owner == -1 || frameNode(shmData, i) == processTable[owner].homeNode ||
+            __atomic_exchange_n(&frames[i].hotness, 0, __ATOMIC_RELAXED) < MIGRATE_THRESHOLD) {
+            continue;
+        }
+
+        //LOOK FOR ROOM ON THE HOME NODE
+        home = processTable[owner].homeNode;
+        target = takeFreeFrame(home);
+        if (target == -1) {
+            continue;
+        }
+
+        //COPY THE PAGE, REPOINT THE PAGE TABLE, THEN FREE THE OLD FRAME
+        //(the old frame is held throughout, a worker hitting it fails its lock and asks oss)
+        lockFrame(i);
+        lockWord = frames[target].lock;
+        frames[target] = frames[i];
+        frames[target].lock = lockWord;
+        frames[target].hotness = 0;
+        if (swapEnabled()) {
+            swapCopyPage(frameBytes(shmData, target), frameBytes(shmData, i));
+        }
+        iptInsert(frames[i].pid, frames[i].pageNumber, target);
+        addToClock(tlbShootdown(frames[i].pid, frames[i].pageNumber, -1));
+        releaseFrame(i);
+        frameUnlock(&frames[i]);
+        pageMigrations++;
+        addToClock(MIGRATE_NANO);
+        cout << "OSS: Migrated page " << frames[target].pageNumber << " of P" << owner << " from frame " << i << " to frame " << target << " on node " << home << endl;
+        if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+            file << "OSS: Migrated page " << frames[target].pageNumber << " of P" << owner << " from frame " << i << " to frame " << target << " on node " << home << endl;
+            logLinesWritten++;
+        }
+    }
+}
+
+// FUNCTION TO ANSWER EVERY BLOCKED REQUEST WHOSE PAGE LOAD HAS FINISHED
+void unblockReadyProcesses(ofstream& file, bool verbose) {
+    msgBuffer buf;
+    long long timeNow;
+    long long unblockTime;
+    int fIdx;
+
+    //LATENCY CLASS REQUESTS ARE ANSWERED FIRST
+    for (int cls = 0; cls < NUM_CLASSES; cls++) {
+        for (auto it = blockedQueue.begin(); it != blockedQueue.end(); ) {
+            timeNow = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano;
+            unblockTime = (long long)it->unblockAtSec * SECOND + it->unblockAtNano;
+
+            //drop loads for processes that exited while blocked
+            if (findProcessIndex(it->pid) == -1) {
+                it = blockedQueue.erase(it);
+                continue;
+            }
+
+            //check if time to unblock (loads still waiting for the backing store have no time yet)
+            if (it->priority == cls && it->ioState == IO_READY && timeNow >= unblockTime) {
+                fIdx = it->frameIndex;
+
+                //set frame
+                frames[fIdx].occupied = true;
+                frames[fIdx].pid = it->pid;
+                frames[fIdx].pageNumber = it->page;
+                if (it->dirty) {
+                    frames[fIdx].dirty = true;
+                }
+                frames[fIdx].loading = false;
+                touchFrame(fIdx);
+                iptInsert(it->pid, it->page, fIdx);
+                tlbFill(it->processIndex, it->page, fIdx);
+                //send message back
+                buf.mtype = WORKER_MTYPE(processTable[it->processIndex].workerPid);
+                buf.pid = it->pid;
+                buf.status = 0;
+                buf.address = it->address;
+                buf.action = it->action;
+                buf.requestId = it->requestId;
+                buf.frame = fIdx;
+                cout << "OSS unblocking P" << it->processIndex << " after page load\n";
+                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                    file << "OSS: unblocking P" << it->processIndex << " after page load\n";
+                    logLinesWritten++;
+                }
+                if (sendMessage(msqid, &buf) == -1) {
+                    cerr << "OSS: msgsnd failed on unblock\n";
+                    exit(1);
+                }
+                faultStallNano += timeNow - it->requestTime;
+                faultsCompleted++;
+                faultLatencies.push_back(timeNow - it->requestTime);
+                classFaultLatencies[cls].push_back(timeNow - it->requestTime);
+                completeRequest(it->processIndex, it->requestTime);
+                cout << "OSS: Indicating to P" << it->processIndex << " that " << (it->action == 0 ? "read" : "write") << " has happened to address " << it->address << endl;
+                cout << "OSS: Finished page load for PID " << it->pid << " (page " << it->page << ") into frame " << fIdx << endl;
+                if (verbose && (logLinesWritten < MAX_LOG_LINES)) {
+                    file << "OSS: Indicating to P" << it->processIndex << " that " << (it->action == 0 ? "read" : "write") << " has happened to address " << it->address << endl;
+                    logLinesWritten++;
+                    file << "OSS: Finished page load for PID " << it->pid << " (page " << it->page << ") into frame " << fIdx << endl;
+                    logLinesWritten++;
+                }
+                it = blockedQueue.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    //FINISHED LOADS LET FAULTS WAITING FOR A FRAME EVICT ONE, AND FREE BACKING STORE SLOTS FOR WAITING LOADS
+    assignWaitingFrames(file, verbose);
+    dispatchBackingStoreIo();
+}
+
+// FUNCTION TO RECORD THE LATENCY OF A REQUEST THAT WAS JUST ANSWERED
+void completeRequest(int processIndex, long long requestTime) {
+    long long latency = (long long)shmData->clock.seconds * SECOND + shmData->clock.nano - requestTime;
+    processTable[processIndex].inFlight--;
+    processTable[processIndex].stallNano += latency;
+    requestsCompleted++;
+    requestLatencyNano += latency;
+}
+
+// FUNCTION TO CLEAR PCB OF TERMINATED CHILD IN PROCESS TABLE
+void updatePCBofTerminatedChild(pid_t termPid) {
+    int frameIdx;
+    collectLocalHits(); // count its last hits before the entry is cleared
+    for (int i = 0; i < MAX_PROCS; i++) {
+        if (processTable[i].occupied == 1 && processTable[i].pid == termPid) {
+            //count the data checks its worker made (real data mode)
+            dataTouches += shmData->dataTouches[i];
+            dataErrors += shmData->dataErrors[i];
+            dataRaces += shmData->dataRaces[i];
+            //release all frames and cached pages held by the child
+            for (frameIdx = 0; frameIdx < activeFrames; frameIdx++) {
+                if (frames[frameIdx].occupied && frames[frameIdx].pid == termPid) {
+                    if (swapEnabled() && !pageHeaderMatches(frameBytes(shmData, frameIdx), termPid, frames[frameIdx].pageNumber)) {
+                        residentHeaderErrors++;
+                        cerr << "ERROR: frame " << frameIdx << " holds another page's data, expected page " << frames[frameIdx].pageNumber << " of PID " << termPid << endl;
+                    }
+                    iptRemove(termPid, frames[frameIdx].pageNumber);
+                    releaseFrame(frameIdx);
+                }
+            }
+            zswapInvalidateProcess(termPid);
+            swapInvalidateProcess(termPid);
+            unscheduleProcess(i);
+            processTable[i].occupied = 0;
+            processTable[i].pid = 0;
+            processTable[i].startSeconds = 0;
+            processTable[i].startNano = 0;
+            processTable[i].messagesSent = 0;
+        }
+    }
+}
+
+// FUNCTION TO OUTPUT THE PROCESS TABLE
+void outputProcessTable() {
+    cout << "OSS PID: " << getpid() << " SysClockS: " << shmData->clock.seconds << " SysClockNano: " << shmData->clock.nano << endl;
+    cout << "Process Table:" << endl;
+    cout << setw(5) << "Entry";
+    cout << setw(10) << "Occupied";
+    cout << setw(10) << "PID";
+    cout << setw(10) << "StartS";
+    cout << setw(10) << "StartN";
+    cout << setw(10) << "Msgs Sent" << endl;
+    for (int i = 0; i < 20; i++) {
+        cout << setw(5) << i;
+        cout << setw(10) << processTable[i].occupied;
+        cout << setw(10) << processTable[i].pid;
+        cout << setw(10) << processTable[i].startSeconds;
+        cout << setw(10) << processTable[i].startNano;
+        cout << setw(10) << processTable[i].messagesSent;
+        cout << endl;
+    }
+}
+
+// FUNCTION TO HANDLE TIMEOUT SIGNAL
+void signal_handler(int sig) {
+    //send kill command to all children based on pids in proc table
+    for (int i = 0; i < 20; i++) {
+        if (processTable[i].occupied == 1 && processTable[i].workerPid > 0) {
+            if (kill(processTable[i].workerPid, SIGTERM) == 0) {
+                cout << "Successfully killed process " << processTable[i].workerPid << endl;
+            }
+            else {
+                cerr << "ERROR: unable to kill process " << processTable[i].workerPid << endl;
+            }
+        }
+        processTable[i].occupied = 0;
+        processTable[i].pid = 0;
+        processTable[i].startSeconds = 0;
+        processTable[i].startNano = 0;
+    }
+
+    cout << "Active children at alarm time: " << countActiveChildren() << endl;
+
+    //idle pooled workers aren't in the process table
+    for (PoolWorker& worker : workerPool) {
+        if (!worker.busy) {
+            kill(worker.pid, SIGTERM);
+        }
+    }
+
+    //free shm, message queue and swap file then exit (the unwritten batch is dropped)
+    //_exit skips the global destructors, which would free memory and deadlock if the alarm
+    //interrupted malloc (the lines above end in endl, so nothing is left unflushed)
+    swapAbort();
+    msgctl(msqid, IPC_RMID, NULL);
+    shmdt(shmData);
+    shmctl(shmid, IPC_RMID, NULL);
+    _exit(1);
+}
+
+// FUNCTION TO COUNT THE ACTIVE CHILDREN IN THE SYSTEM
+int countActiveChildren() {
+    int activeChildCount = 0;
+    for (int i = 0; i < 20; i++) {
+        if (processTable[i].occupied == 1) {
+            activeChildCount++;
+        }
+    }
+    return activeChildCount;
+}
+
+// FUNCTION TO CHECK IF THERE IS AN OPEN SPOT IN THE PROCESS TABLE
+int openSpaceInTable() {
+    for (int i = 0; i < 20; i++) {
+        if (processTable[i].occupied == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// FUNCTION TO CHECK IF IT IS TIME TO LAUNCH A NEW PROCESS
+bool timeToLaunchProcess(int lastChildLaunchTimeSec, int lastChildLaunchTimeNano, int launchInterval) {
+    int lastChildLaunchTimeMs = (lastChildLaunchTimeSec * 1000) + (lastChildLaunchTimeNano / 1000000);
+    int currentTimeMs = (shmData->clock.seconds * 1000) + (shmData->clock.nano / 1000000);
+    return ((currentTimeMs - lastChildLaunchTimeMs) >= launchInterval);
+}
+
+// FUNCTION TO FIND A SPECIFIC PROCESS IN THE PROCESS TABLE
+int findProcessIndex(pid_t pid) {
+    for (int i = 0; i < 20; i++) {
+        if (processTable[i].occupied && processTable[i].pid == pid) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// FUNCTION TO OUTPUT THE FRAME TABLE INFORMATION
+void outputFrameTable(ofstream& file) {
+    cout << "\nCurrent memory layout at time " << shmData->clock.seconds << ":" << shmData->clock.nano << " is:\n";
+    cout << setw(8) << "Frame" << setw(10) << "PID" << setw(14) << "Page" << setw(10) << "Dirty" << setw(6) << "Ref" << setw(15) << "LastRefS" << setw(15) << "LastRefNano" << endl;
+
+    file << "\nCurrent memory layout at time " << shmData->clock.seconds << ":" << shmData->clock.nano << " is:\n";
+    file << setw(8) << "Frame" << setw(10) << "PID" << setw(14) << "Page" << setw(10) << "Dirty" << setw(6) << "Ref" << setw(15) << "LastRefS" << setw(15) << "LastRefNano" << endl;
+    logLinesWritten += 2;
+    for (int i = 0; i < activeFrames; ++i) {
+        if (frames[i].occupied) {
+            cout << setw(8) << i << setw(10) << frames[i].pid << setw(14) << frames[i].pageNumber << setw(10) << frames[i].dirty << setw(6) << frames[i].referenced << setw(15) << frames[i].lastRefSec << setw(15) << frames[i].lastRefNano << endl;
+            file << setw(8) << i << setw(10) << frames[i].pid << setw(14) << frames[i].pageNumber << setw(10) << frames[i].dirty << setw(6) << frames[i].referenced << setw(15) << frames[i].lastRefSec << setw(15) << frames[i].lastRefNano << endl;
+        }
+        else {
+            cout << setw(8) << i << " (empty)\n";
+            file << setw(8) << i << " (empty)\n";
+        }
+    }
+    cout << "\nPage Tables (vpn:frame, vpn in hex): ";
+    file << "\nPage Tables (vpn:frame, vpn in hex): ";
+    logLinesWritten++;
+
+    for (int i = 0; i < MAX_PROCS; ++i) {
+        if (processTable[i].occupied) {
+            cout << "P" << i << ": [ ";
+            file << "P" << i << ": [ ";
+            for (int j = 0; j < activeFrames; ++j) {
+                if (frames[j].occupied && frames[j].pid == processTable[i].pid) {
+                    cout << hex << frames[j].pageNumber << dec << ":" << j << " ";
+                    file << hex << frames[j].pageNumber << dec << ":" << j << " ";
+                }
+            }
+            cout << "]\n";
+            file << "]\n";
+        }
+    }
+}
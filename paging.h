@@ -0,0 +1,199 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      paging.h
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This header holds the address geometry and replacement
+//                   policies used by oss and worker. The page size is a
+//                   template parameter, so splitting an address compiles to a
+//                   shift and a mask. The policies' touch and victim hooks are
+//                   inlined into oss, which keeps its own fault path around the
+//                   shared page table. ReplayEngine is a separate, simplified
+//                   demand pager over a private frame table and hash map, used
+//                   only by analyze to replay reference traces.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PAGING_H
+#define PAGING_H
+
+#include <unordered_map>
+#include <climits>
+#include "shm.h"
+
+//LOG2 OF A POWER OF TWO, EVALUATED AT COMPILE TIME
+constexpr int log2Exact(unsigned long long n) {
+    return n <= 1 ? 0 : 1 + log2Exact(n >> 1);
+}
+
+//ADDRESS SPLITTING FOR A COMPILE-TIME PAGE SIZE
+template <unsigned long long PageSize>
+struct PageGeometry {
+    static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "page size must be a power of two");
+    static constexpr int shift = log2Exact(PageSize);
+    static constexpr unsigned long long mask = PageSize - 1;
+
+    static long long page(unsigned long long address) {
+        return address >> shift;
+    }
+    static int offset(unsigned long long address) {
+        return address & mask;
+    }
+    static unsigned long long address(long long page, int offset) {
+        return ((unsigned long long)page << shift) | offset;
+    }
+};
+
+//THE SIMULATOR'S OWN GEOMETRY MUST AGREE WITH THE SHIFT WORKERS AND THE PAGE TABLE USE
+typedef PageGeometry<PAGE_SIZE> SimGeometry;
+static_assert(SimGeometry::shift == PAGE_SHIFT, "PAGE_SHIFT doesn't match PAGE_SIZE");
+
+//LEAST RECENTLY USED - EVICT THE FRAME WITH THE OLDEST REFERENCE TIME
+struct LruPolicy {
+    static const char* name() {
+        return "lru";
+    }
+
+    void touch(Frame& frame, long long time) {
+        frame.lastRefSec = time / SECOND;
+        frame.lastRefNano = time % SECOND;
+    }
+
+    //canEvict(frame index) filters the candidates, returns -1 if none qualifies
+    template <class CanEvict>
+    int selectVictim(Frame* frames, int activeFrames, CanEvict canEvict) {
+        int victim = -1;
+        long long oldestTime = LLONG_MAX;
+        long long frameTime;
+        for (int i = 0; i < activeFrames; ++i) {
+            if (!canEvict(i)) {
+                continue;
+            }
+            frameTime = ((long long)frames[i].lastRefSec * SECOND) + frames[i].lastRefNano;
+            if (frameTime < oldestTime) {
+                oldestTime = frameTime;
+                victim = i;
+            }
+        }
+        return victim;
+    }
+};
+
+//CLOCK (SECOND CHANCE) - SWEEP A HAND, CLEARING REFERENCE BITS, UNTIL AN UNREFERENCED FRAME TURNS UP
+//reference bits may be set by workers like MMU bits, so they are read and cleared atomically
+struct ClockPolicy {
+    int hand = 0;
+
+    static const char* name() {
+        return "clock";
+    }
+
+    void touch(Frame& frame, long long) {
+        __atomic_store_n(&frame.referenced, true, __ATOMIC_RELAXED);
+    }
+
+    //canEvict(frame index) filters the candidates, returns -1 if none qualifies
+    template <class CanEvict>
+    int selectVictim(Frame* frames, int activeFrames, CanEvict canEvict) {
+        int victim;
+        //two sweeps at most: the first may only clear reference bits
+        for (int i = 0; i < 2 * activeFrames; i++) {
+            victim = hand;
+            hand = (hand + 1) % activeFrames;
+            if (!canEvict(victim)) {
+                continue;
+            }
+            if (!__atomic_exchange_n(&frames[victim].referenced, false, __ATOMIC_RELAXED)) {
+                return victim;
+            }
+        }
+        return -1;
+    }
+};
+
+//TRACE REPLAY - DEMAND PAGING OVER A PRIVATE FRAME TABLE (NO CLOCK, LOADS FINISH AT ONCE)
+//not oss' fault path: no shared page table, zswap, NUMA or write-back costs, so its
+//timings only measure the policy. FrameCount is the table's capacity, the frames
+//actually used are chosen at run time
+template <unsigned long long PageSize, int FrameCount, class Policy>
+class ReplayEngine {
+public:
+    typedef PageGeometry<PageSize> Geometry;
+
+    Frame frames[FrameCount];
+    Policy policy;
+    long long hits;
+    long long faults;
+    long long evictions;
+    long long dirtyEvictions;
+
+    explicit ReplayEngine(int activeFrames) {
+        this->activeFrames = (activeFrames > 0 && activeFrames <= FrameCount) ? activeFrames : FrameCount;
+        usedFrames = 0;
+        time = 0;
+        hits = 0;
+        faults = 0;
+        evictions = 0;
+        dirtyEvictions = 0;
+        for (int i = 0; i < FrameCount; i++) {
+            frames[i] = Frame();
+            frames[i].pid = -1;
+            frames[i].pageNumber = -1;
+        }
+    }
+
+    //ONE REFERENCE BY VIRTUAL ADDRESS, RETURNS TRUE ON A HIT
+    bool access(pid_t pid, unsigned long long address, bool write) {
+        return accessPage(pid, Geometry::page(address), write);
+    }
+
+    //ONE REFERENCE BY VIRTUAL PAGE NUMBER, RETURNS TRUE ON A HIT
+    bool accessPage(pid_t pid, long long page, bool write) {
+        int frame;
+        auto found = pageTable.find(pageKey(pid, page));
+
+        time++;
+        if (found != pageTable.end()) {
+            hits++;
+            policy.touch(frames[found->second], time);
+            frames[found->second].dirty |= write;
+            return true;
+        }
+
+        //PAGE FAULT - TAKE AN UNUSED FRAME OR EVICT ONE
+        faults++;
+        if (usedFrames < activeFrames) {
+            frame = usedFrames++;
+        }
+        else {
+            frame = policy.selectVictim(frames, activeFrames, [](int) { return true; });
+            evictions++;
+            if (frames[frame].dirty) {
+                dirtyEvictions++;
+            }
+            pageTable.erase(pageKey(frames[frame].pid, frames[frame].pageNumber));
+        }
+        frames[frame].occupied = true;
+        frames[frame].pid = pid;
+        frames[frame].pageNumber = page;
+        frames[frame].dirty = write;
+        policy.touch(frames[frame], time);
+        pageTable[pageKey(pid, page)] = frame;
+        return false;
+    }
+
+private:
+    int activeFrames;
+    int usedFrames;
+    long long time;
+    std::unordered_map<long long, int> pageTable; // pageKey(pid, vpn) -> frame
+};
+
+#endif //PAGING_H
@@ -0,0 +1,192 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      profile.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file implements the per-page profiler. Pages are
+//                   sampled by a hash of their key, so the decision needs no
+//                   state and a sampled page is always fully counted. At the
+//                   end the counters are written as a matrix (one row per
+//                   process and metric, one column per sampled page in address
+//                   order) and the pages with the most quick re-faults are
+//                   listed.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBRARIES/NAMESPACE
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include "shm.h"
+#include "profile.h"
+using namespace std;
+
+// PROFILER STATE
+int profilePercent = 0;
+int profileQuickDistance = 0;
+long long profileEvictionCount = 0; // every eviction, sampled or not (the refault distance clock)
+unordered_map<long long, PageProfile> pageProfiles;
+
+// FUNCTION TO FIND THE PROFILE OF A PAGE, NULL IF THE PAGE ISN'T SAMPLED
+static PageProfile* profileFind(pid_t pid, long long page) {
+    long long key = pageKey(pid, page);
+    unsigned long long hash = (unsigned long long)key * 0x9e3779b97f4a7c15ULL;
+
+    if (profilePercent == 0 || (int)((hash >> 32) % 100) >= profilePercent) {
+        return nullptr;
+    }
+    auto found = pageProfiles.find(key);
+    if (found == pageProfiles.end()) {
+        PageProfile profile = { pid, page, 0, 0, 0, 0, 0, 0, -1 };
+        found = pageProfiles.insert({ key, profile }).first;
+    }
+    return &found->second;
+}
+
+// FUNCTION TO START PROFILING percent OF ALL PAGES (0 DISABLES THE PROFILER)
+// a refault within quickDistance evictions of the page's own eviction counts as quick
+void profileInit(int percent, int quickDistance) {
+    profilePercent = percent;
+    profileQuickDistance = quickDistance;
+    profileEvictionCount = 0;
+    pageProfiles.clear();
+}
+
+// FUNCTION TO CHECK IF THE PROFILER IS IN USE
+bool profileEnabled() {
+    return profilePercent > 0;
+}
+
+// FUNCTION TO COUNT AN ACCESS THAT REACHED OSS
+void profileAccess(pid_t pid, long long page) {
+    PageProfile* profile = profileFind(pid, page);
+    if (profile != nullptr) {
+        profile->accesses++;
+    }
+}
+
+// FUNCTION TO COUNT A FAULT, AND ITS REFAULT DISTANCE IF THE PAGE WAS EVICTED BEFORE
+void profileFault(pid_t pid, long long page) {
+    PageProfile* profile = profileFind(pid, page);
+    long long distance;
+    if (profile == nullptr) {
+        return;
+    }
+    profile->faults++;
+    if (profile->evictedAt >= 0) {
+        distance = profileEvictionCount - profile->evictedAt;
+        profile->refaults++;
+        profile->refaultDistance += distance;
+        if (distance <= profileQuickDistance) {
+            profile->quickRefaults++;
+        }
+        profile->evictedAt = -1;
+    }
+}
+
+// FUNCTION TO COUNT AN EVICTION
+void profileEviction(pid_t pid, long long page) {
+    PageProfile* profile;
+    if (profilePercent == 0) {
+        return;
+    }
+    profileEvictionCount++;
+    profile = profileFind(pid, page);
+    if (profile != nullptr) {
+        profile->evictions++;
+        profile->evictedAt = profileEvictionCount;
+    }
+}
+
+// FUNCTION TO COUNT THE SAMPLED PAGES
+long long profileSampledPages() {
+    return pageProfiles.size();
+}
+
+// FUNCTION TO WRITE THE COUNTERS AS A MATRIX, ONE ROW PER (PROCESS, METRIC)
+// columns are the process' sampled pages in address order, the vpn row names them
+void profileWriteHeatmap(const string& fileName) {
+    map<pid_t, vector<const PageProfile*>> byProcess;
+    size_t columns = 0;
+    ofstream out(fileName);
+
+    if (!out) {
+        cerr << "ERROR: heatmap file could not be opened" << endl;
+        exit(1);
+    }
+    for (const auto& entry : pageProfiles) {
+        byProcess[entry.second.pid].push_back(&entry.second);
+    }
+    for (auto& entry : byProcess) {
+        sort(entry.second.begin(), entry.second.end(), [](const PageProfile* a, const PageProfile* b) { return a->page < b->page; });
+        columns = max(columns, entry.second.size());
+    }
+
+    out << "pid,metric";
+    for (size_t c = 0; c < columns; c++) {
+        out << ",p" << c;
+    }
+    out << "\n";
+    for (const auto& entry : byProcess) {
+        out << entry.first << ",vpn";
+        for (const PageProfile* p : entry.second) {
+            out << ",0x" << hex << p->page << dec;
+        }
+        out << "\n" << entry.first << ",accesses";
+        for (const PageProfile* p : entry.second) {
+            out << "," << p->accesses;
+        }
+        out << "\n" << entry.first << ",faults";
+        for (const PageProfile* p : entry.second) {
+            out << "," << p->faults;
+        }
+        out << "\n" << entry.first << ",evictions";
+        for (const PageProfile* p : entry.second) {
+            out << "," << p->evictions;
+        }
+        out << "\n" << entry.first << ",quickRefaults";
+        for (const PageProfile* p : entry.second) {
+            out << "," << p->quickRefaults;
+        }
+        out << "\n" << entry.first << ",avgRefaultDistance";
+        for (const PageProfile* p : entry.second) {
+            out << "," << (p->refaults > 0 ? p->refaultDistance / p->refaults : 0);
+        }
+        out << "\n";
+    }
+}
+
+// FUNCTION TO LIST THE PAGES WITH THE MOST QUICK REFAULTS (EVICTED AND FAULTED RIGHT BACK IN)
+void profilePrintPingPong(ostream& out) {
+    vector<const PageProfile*> pages;
+    for (const auto& entry : pageProfiles) {
+        if (entry.second.quickRefaults > 0) {
+            pages.push_back(&entry.second);
+        }
+    }
+    sort(pages.begin(), pages.end(), [](const PageProfile* a, const PageProfile* b) {
+        return a->quickRefaults != b->quickRefaults ? a->quickRefaults > b->quickRefaults : a->faults > b->faults;
+    });
+    if (pages.size() > PROFILE_TOP) {
+        pages.resize(PROFILE_TOP);
+    }
+
+    out << "PING-PONG PAGES (refaulted within " << profileQuickDistance << " evictions)\n";
+    out << setw(8) << "PID" << setw(16) << "Page" << setw(10) << "Accesses" << setw(8) << "Faults" << setw(11) << "Evictions"
+        << setw(8) << "Quick" << setw(14) << "Avg Distance" << endl;
+    for (const PageProfile* p : pages) {
+        out << setw(8) << p->pid << showbase << hex << setw(16) << p->page << dec << noshowbase
+            << setw(10) << p->accesses << setw(8) << p->faults << setw(11) << p->evictions << setw(8) << p->quickRefaults
+            << setw(14) << (p->refaults > 0 ? p->refaultDistance / p->refaults : 0) << endl;
+    }
+}
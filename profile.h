@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      profile.h
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This header declares the per-page profiler used by oss. A
+//                   hash of each (pid, page) decides whether the page is
+//                   sampled, so only sampled pages cost a table lookup. Every
+//                   sampled page counts accesses, faults and evictions, and
+//                   each re-fault records its distance (evictions since the
+//                   page was evicted). A short distance means the page would
+//                   have stayed resident with a little more memory, so it
+//                   is "ping-ponging" between memory and swap.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <iostream>
+#include <string>
+#include <sys/types.h>
+
+#define PROFILE_TOP 10 // pages in the ping-pong list
+
+//COUNTERS OF ONE SAMPLED PAGE
+struct PageProfile {
+    pid_t pid;
+    long long page;
+    long long accesses;
+    long long faults;
+    long long evictions;
+    long long refaults;          // faults after an eviction
+    long long quickRefaults;     // refaults within the quick distance
+    long long refaultDistance;   // sum of refault distances
+    long long evictedAt;         // eviction count when last evicted, -1 while resident
+};
+
+//FUNCTION PROTOTYPES
+void profileInit(int percent, int quickDistance);
+bool profileEnabled();
+void profileAccess(pid_t pid, long long page);
+void profileFault(pid_t pid, long long page);
+void profileEviction(pid_t pid, long long page);
+long long profileSampledPages();
+void profileWriteHeatmap(const std::string& fileName);
+void profilePrintPingPong(std::ostream& out);
+
+#endif //PROFILE_H
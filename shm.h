@@ -1,70 +1,198 @@
-//////////////////////////////////////////////////////////////////////////////////////
-//
-//      shm.h
-//
-//      Created By: Autumn Rose
-//
-//      CMP SCI 4760 - Operating Systems
-//
-//      Project 6: Paging
-//
-//      Due Date: 15 May 2025
-//
-//      Description: This header defines the structure for the simulated clock and
-//                   resource descriptor - both of which will be in shared memory
-//                   for both oss.cpp and worker.cpp to access, as well as the
-//                   necessary libraries and variables.
-//
-//////////////////////////////////////////////////////////////////////////////////////
-
-#ifndef SHM_H
-#define SHM_H
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <sys/ipc.h>
-#include <sys/shm.h>
-#include <errno.h>
-
-#define SHM_KEY 123456
-#define BUFF_SZ sizeof(ShmClock)
-#define SECOND 1000000000L
-#define MAX_PROCS 20
-#define NUM_RSCS 5
-#define NUM_RSC_INSTANCES 10
-
-#define FRAME_COUNT 256
-#define PAGE_COUNT 32
-#define PAGE_SIZE 1024
-#define TOTAL_MEM 131072 // 128 KB
-
-//FRAME
-struct Frame {
-    bool occupied;
-    pid_t pid;
-    int pageNumber;
-    bool dirty;
-    int lastRefSec;
-    int lastRefNano;
-};
-
-//SIMULATED CLOCK
-struct ShmClock {
-    int seconds;
-    int nano;
-};
-
-//RESOURCE DESCRIPTOR
-struct ResourceDescriptor {
-    int totalInstances;
-    int availableInstances;
-    int allocated[MAX_PROCS];
-};
-
-//COMBINED SHM SEGMENT
-struct ShmSegment {
-    ShmClock clock;
-    ResourceDescriptor resources[NUM_RSCS];
-};
-
-#endif //SHM_H
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      shm.h
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This header defines the structure for the simulated clock,
+//                   resource descriptor, frame table and page tables - all of which
+//                   will be in shared memory for both oss.cpp and worker.cpp to
+//                   access, as well as the necessary libraries and variables.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SHM_H
+#define SHM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <errno.h>
+
+#define BUFF_SZ sizeof(ShmSegment)
+#define SECOND 1000000000L
+#define MAX_PROCS 20
+#define NUM_RSCS 5
+#define NUM_RSC_INSTANCES 10
+
+#define FRAME_COUNT 256
+#define PAGE_COUNT 32      // pages each worker touches, spread over its address space
+#define PAGE_SIZE 1024
+#define PAGE_SHIFT 10      // log2(PAGE_SIZE)
+#define VA_BITS 47         // bits of a 64-bit virtual address a worker may use
+#define PID_BITS 22        // pids stay below 2^22 (Linux pid_max)
+#define TOTAL_MEM (FRAME_COUNT * PAGE_SIZE) // 256 KB, the page contents of every frame (real data mode)
+#define MAX_WINDOW 16      // most requests a worker may have in flight
+#define MAX_NODES 8        // most NUMA memory nodes the frame table can be split into
+
+#define WORKLOAD_UNIFORM 0 // every page equally likely
+#define WORKLOAD_LOCAL 1   // 90% of references go to a small, slowly drifting hot set
+
+//INVERTED PAGE TABLE
+//open-addressed (linear probing) hash keyed on (pid, vpn), twice the frame count so
+//it stays at most half full. oss is the only writer and deletes by shifting entries
+//back instead of leaving tombstones; workers probe it without locks and confirm the
+//frame itself still holds their page, so a probe racing an update just misses.
+#define IPT_SIZE (2 * FRAME_COUNT) // power of two
+#define IPT_EMPTY 0                // pid of an unused slot
+struct IptEntry {
+    pid_t pid;
+    int frame;
+    long long vpn;
+};
+
+//PAGE HEADER
+//in real data mode every page starts with the (pid, vpn) it belongs to, workers never
+//write over it, so a frame holding the wrong page's data is caught on the next access
+#define PAGE_HEADER_BYTES 16
+struct PageHeader {
+    long long pid;
+    long long vpn;
+};
+
+//PRIORITY CLASSES OF SIMULATED PROCESSES
+#define CLASS_LATENCY 0 // latency-critical: served first, frames evicted last
+#define CLASS_BATCH 1
+#define NUM_CLASSES 2
+
+//FRAME
+//referenced and dirty are set by workers like MMU bits, use __atomic builtins on them
+struct Frame {
+    bool occupied;
+    pid_t pid;
+    long long pageNumber; // virtual page number (address >> PAGE_SHIFT)
+    bool dirty;
+    bool referenced;
+    bool loading;       // page load still in progress, not yet usable
+    int hotness;        // accesses since the last migration scan
+    int lastRefSec;
+    int lastRefNano;
+    unsigned long long lock; // ownership lock (generation << 32 | holder pid), see frameTryLock
+};
+
+//SIMULATED CLOCK
+struct ShmClock {
+    int seconds;
+    int nano;
+};
+
+//RESOURCE DESCRIPTOR
+struct ResourceDescriptor {
+    int totalInstances;
+    int availableInstances;
+    int allocated[MAX_PROCS];
+};
+
+//COMBINED SHM SEGMENT
+struct ShmSegment {
+    ShmClock clock;
+    ResourceDescriptor resources[NUM_RSCS];
+    int sharedTables;                       // 1 when workers resolve page hits themselves
+    int asyncWindow;                        // requests a worker may have in flight (1 = synchronous)
+    int workload;                           // WORKLOAD_UNIFORM or WORKLOAD_LOCAL
+    Frame frames[FRAME_COUNT];
+    IptEntry pageTable[IPT_SIZE];           // inverted page table shared by every process
+    long long localHits[MAX_PROCS];         // hits resolved by the worker in that entry
+    long long remoteLocalHits[MAX_PROCS];   // those of the above that touched another node's frame
+    int numaNodes;                          // memory nodes the frame table is split into
+    int framesPerNode;
+    int priority[MAX_PROCS];                // class of the process in that entry (mtype of its requests)
+    int dataMode;                           // 1 when frames hold real page contents in frameData
+    long long dataTouches[MAX_PROCS];       // bytes the worker in that entry read or wrote in frameData
+    long long dataErrors[MAX_PROCS];        // touches that found another page's data in a frame still mapped to it
+    long long dataRaces[MAX_PROCS];         // touches skipped because oss took the frame after answering
+    unsigned char frameData[TOTAL_MEM];     // page contents, frame i starts at i * PAGE_SIZE
+};
+
+//FRAME OWNERSHIP LOCK
+//the lock word holds a generation in its high half and the pid of the holder in its low
+//half (0 while free). oss holds it while it takes a frame away from its page, workers hold
+//it while they set bits (or touch data) in a frame they checked was theirs. A worker reads
+//the word before checking ownership; if the lock then succeeds, oss can't have changed the
+//owner in between, since every release moves to the next generation. Recording the holder
+//lets oss take back a lock whose holder died.
+static inline unsigned long long frameLockWord(Frame* frame) {
+    return __atomic_load_n(&frame->lock, __ATOMIC_ACQUIRE);
+}
+static inline pid_t frameLockHolder(unsigned long long word) {
+    return (pid_t)(word & 0xffffffffULL);
+}
+static inline bool frameTryLock(Frame* frame, unsigned long long word, pid_t holder) {
+    return frameLockHolder(word) == 0 &&
+           __atomic_compare_exchange_n(&frame->lock, &word, word | (unsigned int)holder, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+//releases the lock if it is still held as word (by its holder, or by oss for a dead holder)
+static inline bool frameLockRelease(Frame* frame, unsigned long long word) {
+    return __atomic_compare_exchange_n(&frame->lock, &word, ((word >> 32) + 1) << 32, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+static inline void frameUnlock(Frame* frame) {
+    frameLockRelease(frame, __atomic_load_n(&frame->lock, __ATOMIC_RELAXED));
+}
+
+//KEY OF A (PID, VIRTUAL PAGE) PAIR - VPNS ARE BELOW 2^(VA_BITS - PAGE_SHIFT), SO IT FITS IN 64 BITS
+static inline long long pageKey(pid_t pid, long long vpn) {
+    return (vpn << PID_BITS) | pid;
+}
+
+//CONTENTS OF A FRAME IN REAL DATA MODE
+static inline unsigned char* frameBytes(ShmSegment* shm, int frame) {
+    return shm->frameData + (long long)frame * PAGE_SIZE;
+}
+
+//CHECK THAT A PAGE'S HEADER NAMES THE PAGE IT IS SUPPOSED TO HOLD
+static inline bool pageHeaderMatches(const unsigned char* data, pid_t pid, long long vpn) {
+    PageHeader header;
+    memcpy(&header, data, sizeof(header));
+    return header.pid == pid && header.vpn == vpn;
+}
+
+//HOME SLOT OF A (PID, VIRTUAL PAGE) PAIR IN THE INVERTED PAGE TABLE
+static inline int iptHash(pid_t pid, long long vpn) {
+    unsigned long long x = (unsigned long long)pageKey(pid, vpn) * 0x9e3779b97f4a7c15ULL;
+    return (int)(x >> 32) & (IPT_SIZE - 1);
+}
+
+//FRAME HOLDING A PAGE ACCORDING TO THE INVERTED PAGE TABLE, -1 IF NOT MAPPED
+//probes counts slots examined
+static inline int iptLookup(ShmSegment* shm, pid_t pid, long long vpn, long long* probes) {
+    int slot = iptHash(pid, vpn);
+    pid_t slotPid;
+    for (int i = 0; i < IPT_SIZE; i++) {
+        (*probes)++;
+        slotPid = __atomic_load_n(&shm->pageTable[slot].pid, __ATOMIC_ACQUIRE);
+        if (slotPid == IPT_EMPTY) {
+            return -1;
+        }
+        if (slotPid == pid && __atomic_load_n(&shm->pageTable[slot].vpn, __ATOMIC_RELAXED) == vpn) {
+            return __atomic_load_n(&shm->pageTable[slot].frame, __ATOMIC_RELAXED);
+        }
+        slot = (slot + 1) & (IPT_SIZE - 1);
+    }
+    return -1;
+}
+
+//NUMA NODE HOLDING A FRAME (THE LAST NODE ALSO TAKES ANY LEFTOVER FRAMES)
+static inline int frameNode(const ShmSegment* shm, int frame) {
+    int node = frame / shm->framesPerNode;
+    return node < shm->numaNodes ? node : shm->numaNodes - 1;
+}
+
+#endif //SHM_H
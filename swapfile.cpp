@@ -0,0 +1,305 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      swapfile.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file implements the swap file used in real data mode.
+//                   Dirty evictions are copied into a write batch (which doubles
+//                   as a swap cache for pages faulted straight back in). A full
+//                   batch gives up its pages' old slots and takes one run of
+//                   free slots, so it goes out in a single pwritev, the way a
+//                   log-structured swap allocator clusters writes. Pages that
+//                   were never written out are filled with the synthetic
+//                   contents zswap uses, stamped with their (pid, vpn) header.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBRARIES/NAMESPACE
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <time.h>
+#include "shm.h"
+#include "zswap.h"
+#include "swapfile.h"
+using namespace std;
+
+// SWAPPED PAGE ENTRY
+struct SwapEntry {
+    pid_t pid;
+    long long page;
+    long long slot;              // -1 until the page first reaches the file
+    unsigned long long checksum; // of the contents last stored
+    int batchIndex;              // position in the write batch, -1 once written
+};
+
+// SWAP FILE STATE
+int swapFd = -1;
+string swapPath;
+unordered_map<long long, SwapEntry> swapIndex; // pageKey(pid, vpn) -> entry
+vector<bool> slotUsed;                         // one flag per page slot of the file
+unsigned char batchPages[SWAP_BATCH][PAGE_SIZE];
+long long batchKeys[SWAP_BATCH];
+int batchCount = 0;
+SwapStats swapStats;
+
+// FUNCTION TO READ THE MONOTONIC CLOCK IN NANOSECONDS
+static long long nowNano() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * SECOND + now.tv_nsec;
+}
+
+// FUNCTION TO CHECKSUM ONE PAGE (64-BIT FNV-1a)
+static unsigned long long pageChecksum(const unsigned char* data) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < PAGE_SIZE; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// FUNCTION TO READ ONE SLOT OF THE FILE
+static void readSlot(long long slot, unsigned char* out) {
+    if (pread(swapFd, out, PAGE_SIZE, slot * PAGE_SIZE) != PAGE_SIZE) {
+        cerr << "ERROR: swap file read of slot " << slot << " failed: " << strerror(errno) << endl;
+        exit(1);
+    }
+}
+
+// FUNCTION TO FIND count CONSECUTIVE FREE SLOTS (FIRST FIT), GROWING THE FILE IF NO GAP IS BIG ENOUGH
+static long long findFreeRun(int count) {
+    long long runStart = 0;
+    for (long long slot = 0; slot < (long long)slotUsed.size(); slot++) {
+        if (slotUsed[slot]) {
+            runStart = slot + 1;
+        }
+        else if (slot - runStart + 1 == count) {
+            return runStart;
+        }
+    }
+    //a free run at the end of the file is extended
+    slotUsed.resize(runStart + count, false);
+    swapStats.slotsHigh = slotUsed.size();
+    return runStart;
+}
+
+// FUNCTION TO CREATE THE SWAP FILE AND TURN ON REAL DATA MODE
+// an existing file is refused, since the file is removed at exit
+void swapOpen(const char* path) {
+    swapFd = open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (swapFd == -1 && errno == EEXIST) {
+        cerr << "ERROR: swap file " << path << " already exists, give a path that doesn't." << endl;
+        exit(1);
+    }
+    if (swapFd == -1) {
+        cerr << "ERROR: swap file could not be opened: " << strerror(errno) << endl;
+        exit(1);
+    }
+    swapPath = path;
+    memset(&swapStats, 0, sizeof(swapStats));
+    swapIndex.clear();
+    slotUsed.clear();
+    batchCount = 0;
+}
+
+// FUNCTION TO CHECK IF THE SWAP FILE IS IN USE
+bool swapEnabled() {
+    return swapFd != -1;
+}
+
+// FUNCTION TO STORE AN EVICTED PAGE
+// clean pages need no write: their slot (or their synthetic contents) is still current
+void swapStore(pid_t pid, long long page, const unsigned char* data, bool dirty) {
+    long long key = pageKey(pid, page);
+    long long start;
+    if (!dirty) {
+        swapStats.cleanSkips++;
+        return;
+    }
+
+    auto found = swapIndex.find(key);
+    if (found == swapIndex.end()) {
+        SwapEntry entry = { pid, page, -1, 0, -1 };
+        found = swapIndex.insert({ key, entry }).first;
+    }
+
+    //STAGE IT IN THE WRITE BATCH (A PAGE ALREADY THERE IS JUST OVERWRITTEN)
+    if (found->second.batchIndex == -1) {
+        if (batchCount == SWAP_BATCH) {
+            swapFlush();
+        }
+        found->second.batchIndex = batchCount;
+        batchKeys[batchCount++] = key;
+    }
+    start = nowNano();
+    memcpy(batchPages[found->second.batchIndex], data, PAGE_SIZE);
+    found->second.checksum = pageChecksum(data);
+    swapStats.copyNano += nowNano() - start;
+    swapStats.bytesCopied += PAGE_SIZE;
+}
+
+// FUNCTION TO FILL A FRAME WITH A PAGE'S CONTENTS, CHECKING WHAT COMES BACK
+void swapLoad(pid_t pid, long long page, unsigned char* out) {
+    PageHeader header = { pid, page };
+    long long start = nowNano();
+    auto found = swapIndex.find(pageKey(pid, page));
+
+    if (found == swapIndex.end()) {
+        //NEVER WRITTEN OUT - SYNTHETIC CONTENTS UNDER THE PAGE'S HEADER
+        generatePageContents(pid, page, out);
+        memcpy(out, &header, sizeof(header));
+        swapStats.pagesGenerated++;
+        swapStats.copyNano += nowNano() - start;
+        swapStats.bytesCopied += PAGE_SIZE;
+    }
+    else if (found->second.batchIndex != -1) {
+        //STILL WAITING IN THE WRITE BATCH
+        memcpy(out, batchPages[found->second.batchIndex], PAGE_SIZE);
+        swapStats.batchHits++;
+        swapStats.copyNano += nowNano() - start;
+        swapStats.bytesCopied += PAGE_SIZE;
+    }
+    else {
+        readSlot(found->second.slot, out);
+        swapStats.pagesRead++;
+        swapStats.readCalls++;
+        swapStats.readNano += nowNano() - start;
+    }
+
+    if (found != swapIndex.end() && pageChecksum(out) != found->second.checksum) {
+        swapStats.checksumErrors++;
+        cerr << "ERROR: swap page " << page << " of PID " << pid << " failed its checksum" << endl;
+    }
+    if (!pageHeaderMatches(out, pid, page)) {
+        swapStats.headerErrors++;
+        cerr << "ERROR: swap page " << page << " of PID " << pid << " holds another page's data" << endl;
+    }
+}
+
+// FUNCTION TO WRITE THE BATCH OUT AS ONE pwritev INTO A RUN OF FREE SLOTS
+void swapFlush() {
+    struct iovec iov[SWAP_BATCH];
+    long long runSlot;
+    long long start;
+    if (batchCount == 0) {
+        return;
+    }
+
+    //OLD COPIES ARE OUT OF DATE, SO THEIR SLOTS GO BACK BEFORE THE RUN IS CHOSEN
+    for (int i = 0; i < batchCount; i++) {
+        SwapEntry& entry = swapIndex.at(batchKeys[i]);
+        if (entry.slot != -1) {
+            slotUsed[entry.slot] = false;
+        }
+    }
+    runSlot = findFreeRun(batchCount);
+    for (int i = 0; i < batchCount; i++) {
+        SwapEntry& entry = swapIndex.at(batchKeys[i]);
+        entry.slot = runSlot + i;
+        entry.batchIndex = -1;
+        slotUsed[entry.slot] = true;
+        iov[i].iov_base = batchPages[i];
+        iov[i].iov_len = PAGE_SIZE;
+    }
+
+    start = nowNano();
+    if (pwritev(swapFd, iov, batchCount, runSlot * PAGE_SIZE) != (ssize_t)batchCount * PAGE_SIZE) {
+        cerr << "ERROR: swap file write at slot " << runSlot << " failed: " << strerror(errno) << endl;
+        exit(1);
+    }
+    swapStats.writeNano += nowNano() - start;
+    swapStats.writeCalls++;
+    swapStats.pagesWritten += batchCount;
+    batchCount = 0;
+}
+
+// FUNCTION TO CHECK EVERY SWAPPED PAGE OF A TERMINATED PROCESS, THEN DROP IT FROM THE BATCH AND FREE ITS SLOT
+// pages still in the batch are checked there and never written
+void swapInvalidateProcess(pid_t pid) {
+    unsigned char data[PAGE_SIZE];
+    const unsigned char* copy;
+    int last;
+    if (swapFd == -1) {
+        return;
+    }
+    for (auto it = swapIndex.begin(); it != swapIndex.end(); ) {
+        if (it->second.pid != pid) {
+            ++it;
+            continue;
+        }
+        //THE BATCH COPY IS THE CURRENT ONE, A SLOT WITHOUT ONE IS READ BACK
+        if (it->second.batchIndex != -1) {
+            copy = batchPages[it->second.batchIndex];
+        }
+        else {
+            readSlot(it->second.slot, data);
+            copy = data;
+        }
+        swapStats.pagesVerified++;
+        if (pageChecksum(copy) != it->second.checksum || !pageHeaderMatches(copy, pid, it->second.page)) {
+            swapStats.checksumErrors++;
+            cerr << "ERROR: swap page " << it->second.page << " of PID " << pid << " corrupted in the swap " << (copy == data ? "file" : "batch") << endl;
+        }
+
+        //the last batch page fills the gap
+        if (it->second.batchIndex != -1) {
+            last = --batchCount;
+            if (it->second.batchIndex != last) {
+                memcpy(batchPages[it->second.batchIndex], batchPages[last], PAGE_SIZE);
+                batchKeys[it->second.batchIndex] = batchKeys[last];
+                swapIndex.at(batchKeys[last]).batchIndex = it->second.batchIndex;
+            }
+        }
+        if (it->second.slot != -1) {
+            slotUsed[it->second.slot] = false;
+        }
+        it = swapIndex.erase(it);
+    }
+}
+
+// FUNCTION TO WRITE OUT THE BATCH, CLOSE AND REMOVE THE SWAP FILE
+void swapClose() {
+    if (swapFd == -1) {
+        return;
+    }
+    swapFlush();
+    swapAbort();
+}
+
+// FUNCTION TO CLOSE AND REMOVE THE SWAP FILE WITHOUT WRITING THE BATCH
+// (only close and unlink, so it's safe in a signal handler)
+void swapAbort() {
+    if (swapFd == -1) {
+        return;
+    }
+    close(swapFd);
+    unlink(swapPath.c_str());
+    swapFd = -1;
+}
+
+// FUNCTION TO COPY A PAGE BETWEEN FRAMES (PAGE MIGRATION), COUNTED AS MEMORY TRAFFIC
+void swapCopyPage(unsigned char* dst, const unsigned char* src) {
+    long long start = nowNano();
+    memcpy(dst, src, PAGE_SIZE);
+    swapStats.copyNano += nowNano() - start;
+    swapStats.bytesCopied += PAGE_SIZE;
+}
+
+// FUNCTION TO ACCESS THE SWAP FILE STATISTICS
+const SwapStats& swapGetStats() {
+    return swapStats;
+}
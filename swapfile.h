@@ -0,0 +1,60 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      swapfile.h
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This header declares the swap file used in real data mode.
+//                   Dirty pages evicted from the frame pool are staged in a
+//                   write batch, and a full batch goes to the file in one
+//                   pwritev over consecutive slots. Page-ins read them back
+//                   with pread. Every stored page carries a checksum that is
+//                   checked whenever the page is read back.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SWAPFILE_H
+#define SWAPFILE_H
+
+#include <sys/types.h>
+
+#define SWAP_BATCH 16 // dirty pages staged before the batch is written out
+
+//SWAP FILE STATISTICS (TIMES ARE REAL NANOSECONDS, NOT SIMULATED ONES)
+struct SwapStats {
+    long long pagesWritten;
+    long long writeCalls;     // pwritev calls, one per batch
+    long long pagesRead;
+    long long readCalls;
+    long long pagesGenerated; // loads of pages never written out, filled with synthetic contents
+    long long batchHits;      // loads served from the write batch before it reached the file
+    long long cleanSkips;     // clean evictions that needed no write
+    long long writeNano;
+    long long readNano;
+    long long bytesCopied;    // page contents copied or generated in memory
+    long long copyNano;
+    long long pagesVerified;  // pages read back and checked when their process exited
+    long long checksumErrors;
+    long long headerErrors;
+    long long slotsHigh;      // size of the file in page slots
+};
+
+//FUNCTION PROTOTYPES
+void swapOpen(const char* path);
+bool swapEnabled();
+void swapStore(pid_t pid, long long page, const unsigned char* data, bool dirty);
+void swapLoad(pid_t pid, long long page, unsigned char* out);
+void swapFlush();
+void swapInvalidateProcess(pid_t pid);
+void swapClose();
+void swapAbort();
+void swapCopyPage(unsigned char* dst, const unsigned char* src);
+const SwapStats& swapGetStats();
+
+#endif //SWAPFILE_H
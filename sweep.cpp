@@ -0,0 +1,281 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      sweep.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file runs a grid of oss configurations (frame counts,
+//                   replacement policies, workloads and process counts) in
+//                   parallel, one oss per core, and gathers the CSV row each run
+//                   writes into a single results file. Every oss uses private
+//                   shared memory and a private message queue, so runs don't
+//                   interfere with each other.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBRARIES/NAMESPACE
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+using namespace std;
+
+#define LOG_DIR "sweep_logs"
+#define RUN_TAG "%i"       // replaced by the run index in -x arguments
+#define SWEEP_FLAGS "cf"   // oss flags sweep sets itself
+#define FILE_FLAGS "dgt"   // oss flags naming a file, which every run needs its own copy of
+
+// ONE OSS CONFIGURATION IN THE GRID
+struct SweepRun {
+    string frames;
+    string policy;
+    string workload;
+    string proc;
+    pid_t pid;
+    int status;
+};
+
+// FUNCTION PROTOTYPES
+void printUsage();
+vector<string> splitList(const string&, char);
+bool checkExtraArgs(const vector<string>&);
+pid_t launchRun(int, const SweepRun&, const string&, const string&, const vector<string>&);
+
+// MAIN
+int main(int argc, char** argv) {
+    // VARIABLES FOR COMMAND LINE PARSING
+    vector<string> frameList = { "256" };
+    vector<string> policyList = { "lru" };
+    vector<string> workloadList = { "uniform" };
+    vector<string> procList = { "8" };
+    vector<string> extraArgs;
+    string simul = "4";
+    string interval = "10";
+    string outFile = "sweep.csv";
+    int jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+    // VARIABLES FOR RUNNING THE GRID
+    vector<SweepRun> runs;
+    int nextRun = 0;
+    int running = 0;
+    int finished = 0;
+    int status;
+    pid_t donePid;
+    string header;
+    string line;
+
+    // BEGIN PARSING COMMAND LINE ARGUMENTS USING FLAGS
+    while ((opt = getopt(argc, argv, "hm:p:W:n:s:i:j:o:x:")) != -1) {
+        switch (opt) {
+        case 'h': // h - display help/usage message and exit (success)
+            printUsage();
+            return 0;
+        case 'm': // m flag - comma separated frame counts
+            frameList = splitList(optarg, ',');
+            break;
+        case 'p': // p flag - comma separated replacement policies
+            policyList = splitList(optarg, ',');
+            break;
+        case 'W': // W flag - comma separated workloads
+            workloadList = splitList(optarg, ',');
+            break;
+        case 'n': // n flag - comma separated process counts
+            procList = splitList(optarg, ',');
+            break;
+        case 's': // s flag - simultaneous processes in every run
+            simul = optarg;
+            break;
+        case 'i': // i flag - launch interval in every run
+            interval = optarg;
+            break;
+        case 'j': // j flag - runs to execute at once
+            jobs = atoi(optarg);
+            break;
+        case 'o': // o flag - combined results file
+            outFile = optarg;
+            break;
+        case 'x': // x flag - extra arguments passed to every oss
+            extraArgs = splitList(optarg, ' ');
+            break;
+        default: // default case - display usage and exit
+            cerr << "Usage Invalid.\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (jobs <= 0) {
+        cerr << "ERROR: Argument for flag -j must be a positive integer.\n";
+        return 1;
+    }
+    if (!checkExtraArgs(extraArgs)) {
+        printUsage();
+        return 1;
+    }
+
+    // BUILD THE GRID
+    for (const string& frames : frameList) {
+        for (const string& policy : policyList) {
+            for (const string& workload : workloadList) {
+                for (const string& proc : procList) {
+                    runs.push_back({ frames, policy, workload, proc, -1, -1 });
+                }
+            }
+        }
+    }
+    mkdir(LOG_DIR, 0755);
+    cout << "SWEEP: " << runs.size() << " runs, " << jobs << " at a time" << endl;
+
+    // KEEP UP TO [jobs] RUNS GOING UNTIL THE GRID IS DONE
+    while (finished < (int)runs.size()) {
+        while (running < jobs && nextRun < (int)runs.size()) {
+            runs[nextRun].pid = launchRun(nextRun, runs[nextRun], simul, interval, extraArgs);
+            running++;
+            nextRun++;
+        }
+        donePid = wait(&status);
+        if (donePid == -1) {
+            cerr << "ERROR: wait failed in sweep: " << strerror(errno) << endl;
+            exit(1);
+        }
+        for (SweepRun& run : runs) {
+            if (run.pid == donePid) {
+                run.status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+            }
+        }
+        running--;
+        finished++;
+        cout << "SWEEP: " << finished << " / " << runs.size() << " runs done" << endl;
+    }
+
+    // COMBINE PER-RUN RESULTS INTO ONE CSV
+    ofstream out(outFile);
+    if (!out) {
+        cerr << "ERROR: results file could not be opened" << endl;
+        exit(1);
+    }
+    for (size_t i = 0; i < runs.size(); i++) {
+        ifstream in(string(LOG_DIR) + "/run_" + to_string(i) + ".csv");
+        if (runs[i].status != 0 || !getline(in, line) || !getline(in, line)) {
+            cerr << "SWEEP: run " << i << " (frames " << runs[i].frames << ", " << runs[i].policy << ", " << runs[i].workload
+                 << ", " << runs[i].proc << " procs) failed with status " << runs[i].status << endl;
+            continue;
+        }
+        if (header.empty()) {
+            in.seekg(0);
+            getline(in, header);
+            out << "run," << header << "\n";
+            getline(in, line);
+        }
+        out << i << "," << line << "\n";
+    }
+    cout << "SWEEP: results written to " << outFile << endl;
+    return 0;
+}
+
+// FUNCTION TO PRINT HELP MESSAGE/USAGE
+void printUsage() {
+    cout << "Usage: sweep [-h] [-m frames,...] [-p policy,...] [-W workload,...] [-n proc,...]\n";
+    cout << "             [-s simul] [-i interval] [-j jobs] [-o results.csv] [-x \"oss args\"]\n";
+    cout << " -m frames,...    -> Frame counts to try (default 256)\n";
+    cout << " -p policy,...    -> Replacement policies to try (default lru)\n";
+    cout << " -W workload,...  -> Workloads to try (default uniform)\n";
+    cout << " -n proc,...      -> Total process counts to try (default 8)\n";
+    cout << " -s simul         -> Simultaneous processes in every run (default 4)\n";
+    cout << " -i interval      -> Launch interval in ms for every run (default 10)\n";
+    cout << " -j jobs          -> Runs executed at once (default: number of cores)\n";
+    cout << " -o results.csv   -> Combined results file (default sweep.csv)\n";
+    cout << " -x \"oss args\"    -> Extra arguments passed to every oss run, %i becomes the run index\n";
+    cout << "                     (file arguments of -d, -g and -t must contain %i, -c and -f can't be given)\n";
+}
+
+// FUNCTION TO CHECK THAT EXTRA OSS ARGUMENTS DON'T MAKE PARALLEL RUNS SHARE A FILE
+bool checkExtraArgs(const vector<string>& extraArgs) {
+    string value;
+    for (size_t i = 0; i < extraArgs.size(); i++) {
+        const string& arg = extraArgs[i];
+        if (arg.size() < 2 || arg[0] != '-') {
+            continue;
+        }
+        if (strchr(SWEEP_FLAGS, arg[1])) {
+            cerr << "ERROR: -x can't contain " << arg.substr(0, 2) << ", sweep gives every run its own log and results file.\n";
+            return false;
+        }
+        if (strchr(FILE_FLAGS, arg[1])) {
+            //the file name is attached (-dswap) or the next argument
+            value = arg.size() > 2 ? arg.substr(2) : (i + 1 < extraArgs.size() ? extraArgs[i + 1] : "");
+            if (value.find(RUN_TAG) == string::npos) {
+                cerr << "ERROR: file argument of " << arg.substr(0, 2) << " in -x must contain " << RUN_TAG << " so every run gets its own file.\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// FUNCTION TO SPLIT A DELIMITED LIST, SKIPPING EMPTY ITEMS
+vector<string> splitList(const string& list, char delim) {
+    vector<string> items;
+    stringstream ss(list);
+    string item;
+    while (getline(ss, item, delim)) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// FUNCTION TO FORK AND EXEC ONE OSS RUN, OUTPUT GOES TO ITS OWN LOG FILES
+pid_t launchRun(int index, const SweepRun& run, const string& simul, const string& interval, const vector<string>& extraArgs) {
+    string base = string(LOG_DIR) + "/run_" + to_string(index);
+    string logFile = base + ".log";
+    string csvFile = base + ".csv";
+    vector<string> args = { "oss", "-n", run.proc, "-s", simul, "-i", interval, "-f", logFile,
+                            "-m", run.frames, "-p", run.policy, "-W", run.workload, "-c", csvFile };
+    vector<char*> argvList;
+    pid_t pid;
+    int devNull;
+
+    //EXTRA ARGUMENTS GET THE RUN INDEX IN PLACE OF %i
+    for (string arg : extraArgs) {
+        for (size_t at = arg.find(RUN_TAG); at != string::npos; at = arg.find(RUN_TAG, at)) {
+            arg.replace(at, strlen(RUN_TAG), to_string(index));
+        }
+        args.push_back(arg);
+    }
+    unlink(csvFile.c_str());
+    pid = fork();
+    if (pid < 0) {
+        cerr << "ERROR: Fork failed." << endl;
+        exit(1);
+    }
+    else if (pid == 0) {
+        //console output of oss and its workers isn't needed, the log file has it
+        devNull = open("/dev/null", O_WRONLY);
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+        for (string& arg : args) {
+            argvList.push_back(&arg[0]);
+        }
+        argvList.push_back(nullptr);
+        execv("./oss", argvList.data());
+        cerr << "ERROR: Exec failed." << endl;
+        exit(1);
+    }
+    return pid;
+}
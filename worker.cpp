@@ -1,132 +1,336 @@
-//////////////////////////////////////////////////////////////////////////////////////
-//
-//      worker.cpp
-//
-//      Created By: Autumn Rose
-//
-//      CMP SCI 4760
-//
-//      Project 6: Paging
-//
-//      Due Date: 15 May 2025
-//
-//      Description: This file is executed by oss and simulates doing work and
-//              memory management via paging. Worker will decide whether to read
-//              or write and send a message to oss with its request, and wait for
-//              its memory request to be granted.
-//
-//////////////////////////////////////////////////////////////////////////////////////
-
-// INCLUDED LIBARIES/NAMESPACE
-#include <iostream>
-#include <unistd.h>
-#include <sys/types.h>
-#include <sys/ipc.h>
-#include <sys/msg.h>
-#include <cstdlib>
-#include <cstring>
-#include "shm.h"
-#include "msgq.h"
-using namespace std;
-
-#define PAGE_COUNT 32
-#define PAGE_SIZE 1024
-#define ADDRESS_SPACE (PAGE_COUNT * PAGE_SIZE) // 32768
-#define READ_CHANCE 80
-#define TERMINATE_INTERVAL 1000
-
-// MAIN
-int main(int argc, char** argv) {
-    int shmid;
-    msgBuffer buf;
-    buf.mtype = 1;
-    int msqid = 0;
-    key_t key;
-    bool terminated = false;
-    int action;
-    int accessCount = 0;
-    int terminateThreshold = 20 + (rand() % 5); // for testing
-    int page;
-    int offset;
-    int address;
-
-    // SETUP ACCESS TO MESSAGE QUEUE
-    if ((key = ftok("msgq.txt", 1)) == -1) { //get key
-        cerr << "ERROR: ftok in worker " << getpid() << endl;
-        exit(1);
-    }
-    if ((msqid = msgget(key, PERMS)) == -1) { //create queue
-        cerr << "ERROR: msgget in worker " << getpid() << endl;
-        exit(1);
-    }
-
-    // ATTACH TO SHARED MEMORY TO VIEW CLOCK
-    shmid = shmget(SHM_KEY, BUFF_SZ, 0666);
-    if (shmid == -1) {
-        cerr << "ERROR: Failed to get shared memory in worker." << strerror(errno) << endl;
-        exit(1);
-    }
-    ShmSegment* shmData = (ShmSegment*)shmat(shmid, NULL, 0);
-    if (shmData == (void*)-1) {
-        cerr << "ERROR: Failed to attach to shared memory in worker." << endl;
-        exit(1);
-    }
-
-    while (!terminated) {
-        //GENERATE RANDOM VIRTUAL ADDRESS (0-32767)
-        page = rand() % PAGE_COUNT;
-        offset = rand() % PAGE_SIZE;
-        address = (page * PAGE_SIZE) + offset;
-
-        //DETERMINE READ OR WRITE
-        action = (rand() % 100 < READ_CHANCE) ? 0 : 1;
-
-        //SEND MESSAGE
-        buf.mtype = 1;
-        buf.pid = getpid();
-        buf.address = address;
-        buf.action = action;
-        buf.status = 0;
-
-        if (msgsnd(msqid, &buf, sizeof(msgBuffer) - sizeof(long), 0) == -1) {
-            cerr << "ERROR: msgsnd memory request failed\n";
-            exit(1);
-        }
-
-        //WAIT FOR RESPONSE
-        if (msgrcv(msqid, &buf, sizeof(msgBuffer), getpid(), 0) == -1) {
-            cerr << "ERROR: msgrcv response failed\n";
-            exit(1);
-        }
-        accessCount++;
-        cout << "Worker " << getpid() << " accessCount: " << accessCount << " / " << terminateThreshold << endl;
-
-        //CHECK WHETHER TO TERMINATE
-        if (accessCount >= terminateThreshold) {
-            cout << "Worker " << getpid() << " hit threshold with accessCount = " << accessCount << endl;
-            int termChance = rand() % 100;
-            if (termChance < 20) {
-                cout << "WORKER " << getpid() << " deciding to terminate.\n";
-                buf.mtype = 1;
-                buf.pid = getpid();
-                buf.status = -1;
-                cout << "WORKER " << getpid() << " sending termination msg.\n";
-                if (msgsnd(msqid, &buf, sizeof(msgBuffer) - sizeof(long), 0) == -1) {
-                    cerr << "ERROR: msgsnd termination failed\n";
-                    exit(1);
-                }
-
-                terminated = true;
-            }
-            else {
-                //RESET ACCESS COUNT
-                accessCount = 0;
-                terminateThreshold = 1000 + (rand() % 201);
-            }
-        }
-    }
-
-    // DETACH FROM SHARED MEMORY
-    shmdt(shmData);
-    return 0;
-}
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      worker.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file is executed by oss and simulates doing work and
+//              memory management via paging. Worker will decide whether to read
+//              or write and send a message to oss with its request, and wait for
+//              its memory request to be granted. When oss shares its page tables,
+//              hits are resolved here by setting the frame's reference/dirty bits
+//              and only page faults are sent to oss. With a request window above
+//              one, requests are tagged with IDs and several may be in flight.
+//              A pooled worker (slot -1) runs one simulated process after another
+//              as oss assigns them, using the simulated pid oss hands it.
+//              When frames hold real contents, every access also reads or
+//              writes the addressed byte and checks the page's header.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBARIES/NAMESPACE
+#include <iostream>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <cstdlib>
+#include <cstring>
+#include "shm.h"
+#include "msgq.h"
+#include "paging.h"
+using namespace std;
+
+#define REGION_COUNT 4     // code, heap, mmap and stack regions of the address space
+#define PAGES_PER_REGION (PAGE_COUNT / REGION_COUNT)
+#define READ_CHANCE 80
+#define TERMINATE_INTERVAL 1000
+#define HOT_PAGES 4        // size of the hot set for the local workload
+#define HOT_CHANCE 90      // percent of references that go to the hot set
+#define HOT_SHIFT 200      // references between hot set moves
+
+pid_t lockHolder; // this process' pid, recorded in the frame locks it holds
+
+// FUNCTION TO CHECK THAT A FRAME STILL HOLDS THIS PROCESS' PAGE
+bool isMyFrame(ShmSegment* shmData, int frameIndex, pid_t myPid, long long page) {
+    Frame& frame = shmData->frames[frameIndex];
+    return __atomic_load_n(&frame.occupied, __ATOMIC_ACQUIRE) &&
+           !__atomic_load_n(&frame.loading, __ATOMIC_ACQUIRE) &&
+           __atomic_load_n(&frame.pid, __ATOMIC_RELAXED) == myPid &&
+           __atomic_load_n(&frame.pageNumber, __ATOMIC_RELAXED) == page;
+}
+
+// FUNCTION TO RESOLVE A PAGE HIT WITHOUT OSS, THE WAY AN MMU WOULD
+// returns the frame holding the page, or -1 on a fault (or if shared page tables are off) so the request goes to oss
+int resolveLocalHit(ShmSegment* shmData, int slot, pid_t myPid, long long page, int action) {
+    int frameIndex;
+    unsigned long long lockWord;
+    long long probes = 0;
+    if (!shmData->sharedTables || slot < 0) {
+        return -1;
+    }
+    frameIndex = iptLookup(shmData, myPid, page, &probes);
+    if (frameIndex == -1) {
+        return -1;
+    }
+    //oss may be evicting the frame, if so fall back to a request
+    lockWord = frameLockWord(&shmData->frames[frameIndex]);
+    if (!isMyFrame(shmData, frameIndex, myPid, page) || !frameTryLock(&shmData->frames[frameIndex], lockWord, lockHolder)) {
+        return -1;
+    }
+    //the owner can't change while the lock is held, so the bits land on this page
+    __atomic_store_n(&shmData->frames[frameIndex].referenced, true, __ATOMIC_RELAXED);
+    if (action == 1) {
+        __atomic_store_n(&shmData->frames[frameIndex].dirty, true, __ATOMIC_RELAXED);
+    }
+    frameUnlock(&shmData->frames[frameIndex]);
+    __atomic_fetch_add(&shmData->frames[frameIndex].hotness, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shmData->localHits[slot], 1, __ATOMIC_RELAXED);
+    if (frameNode(shmData, frameIndex) != slot % shmData->numaNodes) {
+        __atomic_fetch_add(&shmData->remoteLocalHits[slot], 1, __ATOMIC_RELAXED);
+    }
+    return frameIndex;
+}
+
+// FUNCTION TO READ OR WRITE THE BYTE AN ADDRESS NAMES IN THE FRAME HOLDING IT (REAL DATA MODE)
+// if oss took the frame after answering the access is skipped, otherwise the frame lock keeps
+// it ours, so a header naming another page before or after the access is corruption
+void touchPageData(ShmSegment* shmData, int slot, pid_t myPid, unsigned long long address, int action, int frameIndex, unsigned char value) {
+    long long page = SimGeometry::page(address);
+    int offset = SimGeometry::offset(address);
+    unsigned char* data;
+    unsigned long long lockWord;
+    volatile unsigned char byte;
+    if (!shmData->dataMode || slot < 0 || frameIndex < 0 || frameIndex >= FRAME_COUNT) {
+        return;
+    }
+    lockWord = frameLockWord(&shmData->frames[frameIndex]);
+    if (!isMyFrame(shmData, frameIndex, myPid, page) || !frameTryLock(&shmData->frames[frameIndex], lockWord, lockHolder)) {
+        __atomic_fetch_add(&shmData->dataRaces[slot], 1, __ATOMIC_RELAXED);
+        return;
+    }
+    data = frameBytes(shmData, frameIndex);
+    if (!pageHeaderMatches(data, myPid, page)) {
+        __atomic_fetch_add(&shmData->dataErrors[slot], 1, __ATOMIC_RELAXED);
+        cerr << "ERROR: worker " << myPid << " found another page's data in frame " << frameIndex << " (page " << page << ")" << endl;
+        frameUnlock(&shmData->frames[frameIndex]);
+        return;
+    }
+
+    //THE HEADER IS NEVER WRITTEN, OFFSETS INSIDE IT USE THE FIRST BYTE AFTER IT
+    if (offset < PAGE_HEADER_BYTES) {
+        offset = PAGE_HEADER_BYTES;
+    }
+    if (action == 1) {
+        data[offset] = value;
+    }
+    else {
+        byte = data[offset];
+        (void)byte;
+    }
+    //NOTHING MAY HAVE CHANGED THE FRAME WHILE IT WAS LOCKED
+    if (!isMyFrame(shmData, frameIndex, myPid, page) || !pageHeaderMatches(data, myPid, page)) {
+        __atomic_fetch_add(&shmData->dataErrors[slot], 1, __ATOMIC_RELAXED);
+        cerr << "ERROR: worker " << myPid << " saw frame " << frameIndex << " (page " << page << ") change during its access" << endl;
+    }
+    frameUnlock(&shmData->frames[frameIndex]);
+    __atomic_fetch_add(&shmData->dataTouches[slot], 1, __ATOMIC_RELAXED);
+}
+
+// FUNCTION TO SCATTER THE PROCESS' REGIONS OVER A 47-BIT ADDRESS SPACE (FIRST VPN OF EACH)
+void layoutRegions(long long regionBase[REGION_COUNT]) {
+    long long topVpn = (1LL << (VA_BITS - PAGE_SHIFT)) - 1;
+    regionBase[0] = 0x400000LL >> PAGE_SHIFT;                                             // code
+    regionBase[1] = (0x600000LL >> PAGE_SHIFT) + rand() % 4096;                           // heap
+    regionBase[2] = (0x7f0000000000LL >> PAGE_SHIFT) + ((long long)rand() << 8) % (1LL << 28); // mmap
+    regionBase[3] = topVpn - PAGES_PER_REGION - rand() % 1024;                            // stack
+}
+
+// FUNCTION TO RUN ONE SIMULATED PROCESS UNTIL IT DECIDES TO TERMINATE
+void runProcess(ShmSegment* shmData, int msqid, int slot, pid_t myPid) {
+    msgBuffer buf;
+    bool terminated = false;
+    int action;
+    int accessCount = 0;
+    int terminateThreshold; // for testing
+    int pageIndex;
+    long long page;
+    int offset;
+    unsigned long long address;
+    long long regionBase[REGION_COUNT];
+    int hotBase = 0;
+    int references = 0;
+    int window = shmData->asyncWindow > 1 ? shmData->asyncWindow : 1;
+    int outstanding = 0;
+    int nextRequestId = 0;
+    int rcvFlags;
+    int frameIndex;
+    long requestType = (shmData->priority[slot] == CLASS_LATENCY) ? OSS_MTYPE_LATENCY : OSS_MTYPE_BATCH;
+
+    //every simulated process gets its own reference stream, pooled or not
+    srand(myPid);
+    terminateThreshold = 20 + (rand() % 5);
+    layoutRegions(regionBase);
+
+    while (!terminated) {
+        //PICK ONE OF THE PROCESS' PAGES
+        if (shmData->workload == WORKLOAD_LOCAL) {
+            if (++references % HOT_SHIFT == 0) {
+                hotBase = rand() % PAGE_COUNT;
+            }
+            pageIndex = (rand() % 100 < HOT_CHANCE) ? (hotBase + rand() % HOT_PAGES) % PAGE_COUNT : rand() % PAGE_COUNT;
+        }
+        else {
+            pageIndex = rand() % PAGE_COUNT;
+        }
+
+        //GENERATE ITS SPARSE 64-BIT VIRTUAL ADDRESS
+        page = regionBase[pageIndex / PAGES_PER_REGION] + pageIndex % PAGES_PER_REGION;
+        offset = rand() % PAGE_SIZE;
+        address = SimGeometry::address(page, offset);
+
+        //DETERMINE READ OR WRITE
+        action = (rand() % 100 < READ_CHANCE) ? 0 : 1;
+
+        //TRY TO RESOLVE A HIT THROUGH THE SHARED PAGE TABLE
+        frameIndex = resolveLocalHit(shmData, slot, myPid, page, action);
+        if (frameIndex != -1) {
+            touchPageData(shmData, slot, myPid, address, action, frameIndex, accessCount);
+            accessCount++;
+        }
+        else if (window > 1) {
+            //ISSUE A TAGGED REQUEST WITHOUT WAITING FOR IT
+            buf.mtype = requestType;
+            buf.pid = myPid;
+            buf.address = address;
+            buf.action = action;
+            buf.status = 0;
+            buf.requestId = nextRequestId++;
+            if (sendMessage(msqid, &buf) == -1) {
+                cerr << "ERROR: msgsnd memory request failed\n";
+                exit(1);
+            }
+            outstanding++;
+
+            //COLLECT FINISHED REQUESTS, BLOCKING ONLY WHEN THE WINDOW IS FULL
+            rcvFlags = (outstanding >= window) ? 0 : IPC_NOWAIT;
+            while (outstanding > 0) {
+                if (msgrcv(msqid, &buf, sizeof(msgBuffer), WORKER_MTYPE(getpid()), rcvFlags) == -1) {
+                    if (errno == ENOMSG) {
+                        break;
+                    }
+                    cerr << "ERROR: msgrcv response failed\n";
+                    exit(1);
+                }
+                outstanding--;
+                touchPageData(shmData, slot, myPid, buf.address, buf.action, buf.frame, accessCount);
+                accessCount++;
+                rcvFlags = IPC_NOWAIT;
+                cout << "Worker " << myPid << " request " << buf.requestId << " done, accessCount: " << accessCount << " / " << terminateThreshold << endl;
+            }
+        }
+        else {
+            //SEND MESSAGE
+            buf.mtype = requestType;
+            buf.pid = myPid;
+            buf.address = address;
+            buf.action = action;
+            buf.status = 0;
+            buf.requestId = nextRequestId++;
+
+            if (sendMessage(msqid, &buf) == -1) {
+                cerr << "ERROR: msgsnd memory request failed\n";
+                exit(1);
+            }
+
+            //WAIT FOR RESPONSE
+            if (msgrcv(msqid, &buf, sizeof(msgBuffer), WORKER_MTYPE(getpid()), 0) == -1) {
+                cerr << "ERROR: msgrcv response failed\n";
+                exit(1);
+            }
+            touchPageData(shmData, slot, myPid, buf.address, buf.action, buf.frame, accessCount);
+            accessCount++;
+            cout << "Worker " << myPid << " accessCount: " << accessCount << " / " << terminateThreshold << endl;
+        }
+
+        //CHECK WHETHER TO TERMINATE
+        if (accessCount >= terminateThreshold) {
+            cout << "Worker " << myPid << " hit threshold with accessCount = " << accessCount << endl;
+            int termChance = rand() % 100;
+            if (termChance < 20) {
+                cout << "WORKER " << myPid << " deciding to terminate.\n";
+                //WAIT FOR EVERY REQUEST STILL IN FLIGHT
+                while (outstanding > 0) {
+                    if (msgrcv(msqid, &buf, sizeof(msgBuffer), WORKER_MTYPE(getpid()), 0) == -1) {
+                        cerr << "ERROR: msgrcv response failed\n";
+                        exit(1);
+                    }
+                    outstanding--;
+                    touchPageData(shmData, slot, myPid, buf.address, buf.action, buf.frame, accessCount);
+                    accessCount++;
+                }
+                buf.mtype = requestType;
+                buf.pid = myPid;
+                buf.status = -1;
+                buf.requestId = -1;
+                cout << "WORKER " << myPid << " sending termination msg.\n";
+                if (sendMessage(msqid, &buf) == -1) {
+                    cerr << "ERROR: msgsnd termination failed\n";
+                    exit(1);
+                }
+
+                terminated = true;
+            }
+            else {
+                //RESET ACCESS COUNT
+                accessCount = 0;
+                terminateThreshold = 1000 + (rand() % 201);
+            }
+        }
+    }
+
+}
+
+// MAIN
+int main(int argc, char** argv) {
+    int shmid;
+    int msqid = 0;
+    int slot;
+    msgBuffer buf;
+
+    // OSS PASSES ITS PROCESS TABLE ENTRY AND THE IDS OF ITS PRIVATE IPC OBJECTS
+    if (argc < 4) {
+        cerr << "ERROR: worker must be launched by oss (worker slot shmid msqid)" << endl;
+        exit(1);
+    }
+    slot = atoi(argv[1]);
+    shmid = atoi(argv[2]);
+    msqid = atoi(argv[3]);
+
+    lockHolder = getpid();
+
+    // ATTACH TO SHARED MEMORY TO VIEW CLOCK
+    ShmSegment* shmData = (ShmSegment*)shmat(shmid, NULL, 0);
+    if (shmData == (void*)-1) {
+        cerr << "ERROR: Failed to attach to shared memory in worker." << strerror(errno) << endl;
+        exit(1);
+    }
+
+    if (slot >= 0) {
+        //LAUNCHED FOR ONE PROCESS
+        runProcess(shmData, msqid, slot, getpid());
+    }
+    else {
+        //POOLED - RUN EVERY PROCESS OSS ASSIGNS UNTIL RETIRED
+        while (true) {
+            if (msgrcv(msqid, &buf, sizeof(msgBuffer), WORKER_MTYPE(getpid()), 0) == -1) {
+                cerr << "ERROR: msgrcv assignment failed: " << strerror(errno) << endl;
+                exit(1);
+            }
+            if (buf.status == MSG_RETIRE) {
+                break;
+            }
+            runProcess(shmData, msqid, buf.address, buf.pid);
+        }
+    }
+
+    // DETACH FROM SHARED MEMORY
+    shmdt(shmData);
+    return 0;
+}
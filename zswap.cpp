@@ -0,0 +1,297 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      zswap.cpp
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This file implements the compressed swap cache used by oss.
+//                   Pages evicted from the frame table are given synthetic
+//                   contents, compressed with a small LZ77 coder, and kept in an
+//                   LRU ordered pool. When the pool fills, the least recently
+//                   stored pages are demoted to the backing store.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+// INCLUDED LIBRARIES/NAMESPACE
+#include <iostream>
+#include <cstring>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include "shm.h"
+#include "zswap.h"
+using namespace std;
+
+#define HASH_BITS 10
+#define MIN_MATCH 3
+#define MAX_MATCH 130
+#define MAX_LITERALS 128
+
+// COMPRESSED PAGE ENTRY
+struct ZswapEntry {
+    pid_t pid;
+    long long page;
+    bool dirty;
+    vector<unsigned char> data;
+};
+
+// POOL STATE
+list<ZswapEntry> zswapLru; // front = most recently stored
+unordered_map<long long, list<ZswapEntry>::iterator> zswapIndex;
+ZswapStats zswapStats;
+
+// FUNCTION TO BUILD THE LOOKUP KEY FOR A PROCESS PAGE
+static long long zswapKey(pid_t pid, long long page) {
+    return pageKey(pid, page);
+}
+
+// FUNCTION TO DROP THE ENTRY AT THE TAIL OF THE POOL
+static void zswapDemoteOldest(int& dirtyDemotions) {
+    ZswapEntry& victim = zswapLru.back();
+    if (victim.dirty) {
+        dirtyDemotions++;
+        zswapStats.dirtyWritebacks++;
+    }
+    zswapStats.poolBytesUsed -= victim.data.size();
+    zswapStats.entries--;
+    zswapStats.demotions++;
+    zswapIndex.erase(zswapKey(victim.pid, victim.page));
+    zswapLru.pop_back();
+}
+
+// FUNCTION TO SIZE THE POOL (0 FRAMES DISABLES THE CACHE)
+void zswapInit(int poolFrames) {
+    memset(&zswapStats, 0, sizeof(zswapStats));
+    zswapStats.poolBytes = poolFrames * PAGE_SIZE;
+    zswapLru.clear();
+    zswapIndex.clear();
+}
+
+// FUNCTION TO CHECK IF THE CACHE IS IN USE
+bool zswapEnabled() {
+    return zswapStats.poolBytes > 0;
+}
+
+// FUNCTION TO COMPRESS AN EVICTED PAGE INTO THE POOL
+// returns false if the page was rejected and must go straight to the backing store
+bool zswapStore(pid_t pid, long long page, bool dirty, int& dirtyDemotions) {
+    unsigned char raw[PAGE_SIZE];
+    unsigned char packed[PAGE_SIZE + PAGE_SIZE / MAX_LITERALS + 1];
+    int packedLen;
+
+    dirtyDemotions = 0;
+    generatePageContents(pid, page, raw);
+    packedLen = compressPage(raw, packed);
+    if (packedLen > (PAGE_SIZE * ZSWAP_MAX_PCT) / 100 || packedLen > zswapStats.poolBytes) {
+        zswapStats.rejects++;
+        return false;
+    }
+
+    //MAKE ROOM BY DEMOTING THE OLDEST ENTRIES
+    while (zswapStats.poolBytesUsed + packedLen > zswapStats.poolBytes) {
+        zswapDemoteOldest(dirtyDemotions);
+    }
+
+    ZswapEntry entry;
+    entry.pid = pid;
+    entry.page = page;
+    entry.dirty = dirty;
+    entry.data.assign(packed, packed + packedLen);
+    zswapLru.push_front(entry);
+    zswapIndex[zswapKey(pid, page)] = zswapLru.begin();
+
+    zswapStats.stores++;
+    zswapStats.entries++;
+    zswapStats.poolBytesUsed += packedLen;
+    zswapStats.rawBytesStored += PAGE_SIZE;
+    zswapStats.compressedBytesStored += packedLen;
+    return true;
+}
+
+// FUNCTION TO RELOAD A PAGE FROM THE POOL, REMOVING IT FROM THE CACHE
+bool zswapLoad(pid_t pid, long long page, bool& dirty) {
+    unsigned char raw[PAGE_SIZE];
+    unsigned char expected[PAGE_SIZE];
+    auto found = zswapIndex.find(zswapKey(pid, page));
+
+    if (found == zswapIndex.end()) {
+        zswapStats.misses++;
+        return false;
+    }
+    ZswapEntry& entry = *found->second;
+    if (decompressPage(entry.data.data(), entry.data.size(), raw) != PAGE_SIZE) {
+        cerr << "ERROR: zswap failed to decompress page " << page << " of PID " << pid << endl;
+        exit(1);
+    }
+    generatePageContents(pid, page, expected);
+    if (memcmp(raw, expected, PAGE_SIZE) != 0) {
+        cerr << "ERROR: zswap page " << page << " of PID " << pid << " corrupted" << endl;
+        exit(1);
+    }
+
+    dirty = entry.dirty;
+    zswapStats.hits++;
+    zswapStats.entries--;
+    zswapStats.poolBytesUsed -= entry.data.size();
+    zswapLru.erase(found->second);
+    zswapIndex.erase(found);
+    return true;
+}
+
+// FUNCTION TO DISCARD EVERY CACHED PAGE OF A TERMINATED PROCESS
+void zswapInvalidateProcess(pid_t pid) {
+    for (auto it = zswapLru.begin(); it != zswapLru.end(); ) {
+        if (it->pid == pid) {
+            zswapStats.entries--;
+            zswapStats.poolBytesUsed -= it->data.size();
+            zswapIndex.erase(zswapKey(it->pid, it->page));
+            it = zswapLru.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+// FUNCTION TO ACCESS THE CACHE STATISTICS
+const ZswapStats& zswapGetStats() {
+    return zswapStats;
+}
+
+// FUNCTION TO FILL A PAGE WITH DETERMINISTIC SYNTHETIC CONTENTS
+// the mix of zero, structured, text-like and random pages gives a spread of ratios
+void generatePageContents(pid_t pid, long long page, unsigned char* out) {
+    static const char* words[] = { "the ", "page ", "frame ", "of ", "process ", "memory ", "and ", "dirty ",
+                                   "clock ", "fault ", "to ", "table ", "a ", "swap ", "in ", "worker " };
+    unsigned int seed = (unsigned int)pid * 2654435761u ^ (unsigned int)(page ^ (page >> 32)) * 40503u;
+    int kind;
+    int zeroTail;
+    int i = 0;
+
+    seed ^= seed >> 15;
+    kind = seed % 8;
+    while (i < PAGE_SIZE) {
+        seed = seed * 1103515245u + 12345u;
+        if (kind < 2) { // mostly zero-filled
+            out[i] = (i < 64) ? (unsigned char)(seed >> 16) : 0;
+            i++;
+        }
+        else if (kind < 4) { // array of 16 byte records with a counter field
+            out[i] = (i % 16 == 0) ? (unsigned char)(i / 16 + page) : (unsigned char)(i % 16 < 8 ? 0 : 0xa0 + i % 16);
+            i++;
+        }
+        else if (kind < 7) { // text built from a small vocabulary
+            const char* word = words[(seed >> 16) % 16];
+            for (int j = 0; word[j] != '\0' && i < PAGE_SIZE; j++) {
+                out[i++] = word[j];
+            }
+        }
+        else { // random data
+            out[i] = (unsigned char)(seed >> 16);
+            i++;
+        }
+    }
+
+    //RANDOMLY SIZED ZERO TAIL (UNUSED HEAP)
+    zeroTail = (seed >> 8) % (PAGE_SIZE / 4);
+    memset(out + PAGE_SIZE - zeroTail, 0, zeroTail);
+}
+
+// FUNCTION TO COMPRESS ONE PAGE
+// tokens: 0x00-0x7f = literal run of (n + 1) bytes,
+//         0x80-0xff = match of (n - 0x80 + MIN_MATCH) bytes followed by a 2 byte offset
+int compressPage(const unsigned char* in, unsigned char* out) {
+    int lastSeen[1 << HASH_BITS];
+    int inPos = 0;
+    int outPos = 0;
+    int litStart = 0;
+
+    for (int i = 0; i < (1 << HASH_BITS); i++) {
+        lastSeen[i] = -1;
+    }
+
+    while (inPos < PAGE_SIZE) {
+        int matchLen = 0;
+        int candidate = -1;
+        if (inPos + MIN_MATCH <= PAGE_SIZE) {
+            unsigned int h = ((in[inPos] << 16) | (in[inPos + 1] << 8) | in[inPos + 2]) * 2654435761u;
+            h >>= (32 - HASH_BITS);
+            candidate = lastSeen[h];
+            lastSeen[h] = inPos;
+            if (candidate >= 0) {
+                while (inPos + matchLen < PAGE_SIZE && matchLen < MAX_MATCH && in[candidate + matchLen] == in[inPos + matchLen]) {
+                    matchLen++;
+                }
+            }
+        }
+
+        if (matchLen >= MIN_MATCH) {
+            //FLUSH PENDING LITERALS
+            while (litStart < inPos) {
+                int run = min(inPos - litStart, MAX_LITERALS);
+                out[outPos++] = (unsigned char)(run - 1);
+                memcpy(out + outPos, in + litStart, run);
+                outPos += run;
+                litStart += run;
+            }
+            int distance = inPos - candidate;
+            out[outPos++] = (unsigned char)(0x80 | (matchLen - MIN_MATCH));
+            out[outPos++] = (unsigned char)(distance >> 8);
+            out[outPos++] = (unsigned char)(distance & 0xff);
+            inPos += matchLen;
+            litStart = inPos;
+        }
+        else {
+            inPos++;
+        }
+    }
+    while (litStart < PAGE_SIZE) {
+        int run = min(PAGE_SIZE - litStart, MAX_LITERALS);
+        out[outPos++] = (unsigned char)(run - 1);
+        memcpy(out + outPos, in + litStart, run);
+        outPos += run;
+        litStart += run;
+    }
+    return outPos;
+}
+
+// FUNCTION TO DECOMPRESS ONE PAGE, RETURNS THE NUMBER OF BYTES PRODUCED
+int decompressPage(const unsigned char* in, int inLen, unsigned char* out) {
+    int inPos = 0;
+    int outPos = 0;
+
+    while (inPos < inLen) {
+        unsigned char token = in[inPos++];
+        if (token < 0x80) {
+            int run = token + 1;
+            if (outPos + run > PAGE_SIZE || inPos + run > inLen) {
+                return -1;
+            }
+            memcpy(out + outPos, in + inPos, run);
+            inPos += run;
+            outPos += run;
+        }
+        else {
+            int len = (token & 0x7f) + MIN_MATCH;
+            if (inPos + 2 > inLen) {
+                return -1;
+            }
+            int distance = (in[inPos] << 8) | in[inPos + 1];
+            inPos += 2;
+            if (distance <= 0 || distance > outPos || outPos + len > PAGE_SIZE) {
+                return -1;
+            }
+            for (int i = 0; i < len; i++) { // byte copy, ranges may overlap
+                out[outPos] = out[outPos - distance];
+                outPos++;
+            }
+        }
+    }
+    return outPos;
+}
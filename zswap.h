@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//      zswap.h
+//
+//      Created By: Autumn Rose
+//
+//      CMP SCI 4760 - Operating Systems
+//
+//      Project 6: Paging
+//
+//      Due Date: 15 May 2025
+//
+//      Description: This header declares the compressed swap cache that sits between
+//                   the frame table and the backing store. Evicted pages are
+//                   compressed into a pool carved from the frame table and can be
+//                   reloaded much faster than a full page-in from the device.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ZSWAP_H
+#define ZSWAP_H
+
+#include <sys/types.h>
+
+#define ZSWAP_STORE_NANO 5000     // 5 us to compress a page into the pool
+#define ZSWAP_LOAD_NANO 10000     // 10 us to decompress a page back into a frame
+#define ZSWAP_MAX_PCT 75          // reject pages that don't compress below 75% of a page
+
+//COMPRESSED CACHE STATISTICS
+struct ZswapStats {
+    long long stores;
+    long long rejects;
+    long long hits;
+    long long misses;
+    long long demotions;
+    long long dirtyWritebacks;
+    long long rawBytesStored;
+    long long compressedBytesStored;
+    int entries;
+    int poolBytesUsed;
+    int poolBytes;
+};
+
+//FUNCTION PROTOTYPES
+void zswapInit(int poolFrames);
+bool zswapEnabled();
+bool zswapStore(pid_t pid, long long page, bool dirty, int& dirtyDemotions);
+bool zswapLoad(pid_t pid, long long page, bool& dirty);
+void zswapInvalidateProcess(pid_t pid);
+const ZswapStats& zswapGetStats();
+
+void generatePageContents(pid_t pid, long long page, unsigned char* out);
+int compressPage(const unsigned char* in, unsigned char* out);
+int decompressPage(const unsigned char* in, int inLen, unsigned char* out);
+
+#endif //ZSWAP_H